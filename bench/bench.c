@@ -0,0 +1,790 @@
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// The accessors/exported cases must call the exported functions even when -DCCSTRING_INLINE_ACCESSORS=ON
+// passes the definition to every consumer; bench_inline.c measures the inline path.
+#undef CCSTRING_INLINE_ACCESSORS
+#include "ccstring.h"
+
+#if defined(CCSTRING_WINDOWS)
+    #include <windows.h>
+#endif
+
+#define BENCH_PAYLOAD_SIZE 65536
+#define BENCH_APPEND_TARGET 4096
+#define BENCH_MAX_ITERATIONS 1000000000u
+
+typedef struct bench_state {
+    size_t iterations;
+    size_t arg;
+    size_t bytes_per_op;
+    double elapsed_ns;
+    double started_ns;
+    size_t allocations;
+    size_t allocations_started;
+} bench_state_t;
+
+typedef void (*bench_fn)(bench_state_t* state);
+
+typedef struct bench_case {
+    const char* name;
+    bench_fn fn;
+    size_t arg;
+} bench_case_t;
+
+typedef struct bench_result {
+    char name[96];
+    size_t iterations;
+    double ns_per_op;
+    double bytes_per_second;
+    double allocs_per_op;
+} bench_result_t;
+
+static char bench_payload[BENCH_PAYLOAD_SIZE + 1];
+static int bench_stats_enabled;
+static volatile size_t bench_sink;
+
+// Allocations and reallocations made by the library on this thread, from the CCSTRING_ENABLE_STATS counters.
+static size_t bench_allocation_count(void)
+{
+    ccstring_stats_t stats;
+    if (!bench_stats_enabled || ccstring_stats_snapshot(&stats) != 0) {
+        return 0;
+    }
+    return stats.allocations + stats.reallocations;
+}
+
+static double bench_now_ns(void)
+{
+#if defined(CCSTRING_WINDOWS)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+#endif
+}
+
+// Benchmarks bracket the measured region with resume/pause so setup and teardown stay untimed.
+static void bench_resume(bench_state_t* state)
+{
+    state->allocations_started = bench_allocation_count();
+    state->started_ns = bench_now_ns();
+}
+
+static void bench_pause(bench_state_t* state)
+{
+    state->elapsed_ns += bench_now_ns() - state->started_ns;
+    state->allocations += bench_allocation_count() - state->allocations_started;
+}
+
+static void bench_new(bench_state_t* state)
+{
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        ccstring_t* str = ccstring_new(bench_payload, state->arg);
+        ccstring_destroy(&str);
+    }
+    bench_pause(state);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_auto(bench_state_t* state)
+{
+    char* text = (char*)malloc(state->arg + 1);
+    memcpy(text, bench_payload, state->arg);
+    text[state->arg] = '\0';
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        ccstring_t* str = ccstring_auto(text);
+        ccstring_destroy(&str);
+    }
+    bench_pause(state);
+
+    free(text);
+    state->bytes_per_op = state->arg;
+}
+
+// One operation is a single append of arg bytes; the string restarts empty every BENCH_APPEND_TARGET bytes.
+static void bench_append(bench_state_t* state)
+{
+    ccstring_t* str = ccstring_new_empty(0);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        if (ccstring_length(str) + state->arg > BENCH_APPEND_TARGET) {
+            ccstring_destroy(&str);
+            str = ccstring_new_empty(0);
+        }
+        ccstring_append(&str, bench_payload, state->arg);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&str);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_copy(bench_state_t* state)
+{
+    ccstring_t* str = ccstring_new_empty(state->arg);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        ccstring_copy(&str, bench_payload, state->arg);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&str);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_view(bench_state_t* state)
+{
+    ccstring_t* str = ccstring_new(bench_payload, state->arg);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        ccstring_view_t* view = ccstring_view_new(str);
+        bench_sink += view->length;
+        ccstring_view_destroy(&view);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&str);
+}
+
+static void bench_slice(bench_state_t* state)
+{
+    ccstring_t* str = ccstring_new(bench_payload, state->arg);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        ccstring_slice_t* slice = ccstring_slice_new(str, 0, state->arg / 2 + 1);
+        bench_sink += slice->length;
+        ccstring_slice_destroy(&slice);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&str);
+}
+
+static void bench_new_from_view(bench_state_t* state)
+{
+    ccstring_view_t view = { bench_payload, state->arg };
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        ccstring_t* str = ccstring_new_from_view(&view);
+        ccstring_destroy(&str);
+    }
+    bench_pause(state);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_compare_equal(bench_state_t* state)
+{
+    ccstring_t* a = ccstring_new(bench_payload, state->arg);
+    ccstring_t* b = ccstring_new(bench_payload, state->arg);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        bench_sink += (size_t)ccstring_compare(a, b);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&a);
+    ccstring_destroy(&b);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_compare_last_byte(bench_state_t* state)
+{
+    ccstring_t* a = ccstring_new(bench_payload, state->arg);
+    ccstring_t* b = ccstring_new(bench_payload, state->arg);
+    b->buffer[state->arg - 1] = 'y';
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        bench_sink += (size_t)ccstring_compare(a, b);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&a);
+    ccstring_destroy(&b);
+    state->bytes_per_op = state->arg;
+}
+
+// One operation is one ccstring_manager_add into a manager that grows to arg entries.
+static void bench_manager_add(bench_state_t* state)
+{
+    ccstring_t** strings = (ccstring_t**)malloc(state->arg * sizeof(*strings));
+    size_t done = 0;
+
+    while (done < state->iterations) {
+        size_t batch = state->iterations - done < state->arg ? state->iterations - done : state->arg;
+        ccstring_manager_t mgr = ccstring_manager_new(1);
+        for (size_t i = 0; i < batch; i++) {
+            strings[i] = ccstring_new(bench_payload, 16);
+        }
+
+        bench_resume(state);
+        for (size_t i = 0; i < batch; i++) {
+            ccstring_manager_add(&mgr, strings[i], 0);
+        }
+        bench_pause(state);
+
+        ccstring_manager_destroy(&mgr);
+        done += batch;
+    }
+
+    free(strings);
+}
+
+// One operation removes the first entry of a manager holding up to arg entries.
+static void bench_manager_remove(bench_state_t* state)
+{
+    ccstring_t** removed = (ccstring_t**)malloc(state->arg * sizeof(*removed));
+    size_t done = 0;
+
+    while (done < state->iterations) {
+        size_t batch = state->iterations - done < state->arg ? state->iterations - done : state->arg;
+        ccstring_manager_t mgr = ccstring_manager_new(state->arg);
+        for (size_t i = 0; i < state->arg; i++) {
+            ccstring_new_add_ref(&mgr, bench_payload, 16);
+        }
+
+        bench_resume(state);
+        for (size_t i = 0; i < batch; i++) {
+            ccstring_manager_remove(&mgr, 0, &removed[i]);
+        }
+        bench_pause(state);
+
+        for (size_t i = 0; i < batch; i++) {
+            ccstring_destroy(&removed[i]);
+        }
+        ccstring_manager_destroy(&mgr);
+        done += batch;
+    }
+
+    free(removed);
+}
+
+// One operation encodes arg bytes of payload into a string that already has enough capacity.
+static void bench_encode_hex(bench_state_t* state)
+{
+    ccstring_t* str = ccstring_new_empty(state->arg * 2);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        str->length = 0;
+        ccstring_append_hex(&str, bench_payload, state->arg, CCSTRING_HEX_LOWERCASE);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&str);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_decode_hex(bench_state_t* state)
+{
+    ccstring_t* text = ccstring_new_empty(0);
+    ccstring_append_hex(&text, bench_payload, state->arg, CCSTRING_HEX_LOWERCASE);
+    ccstring_view_t view = ccstring_view_of(text);
+    ccstring_t* str = ccstring_new_empty(state->arg);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        str->length = 0;
+        ccstring_append_hex_decoded(&str, &view);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&text);
+    ccstring_destroy(&str);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_encode_base64(bench_state_t* state)
+{
+    ccstring_t* str = ccstring_new_empty((state->arg + 2) / 3 * 4);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        str->length = 0;
+        ccstring_append_base64(&str, bench_payload, state->arg);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&str);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_decode_base64(bench_state_t* state)
+{
+    ccstring_t* text = ccstring_new_empty(0);
+    ccstring_append_base64(&text, bench_payload, state->arg);
+    ccstring_view_t view = ccstring_view_of(text);
+    ccstring_t* str = ccstring_new_empty(state->arg);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        str->length = 0;
+        ccstring_append_base64_decoded(&str, &view);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&text);
+    ccstring_destroy(&str);
+    state->bytes_per_op = state->arg;
+}
+
+// Escapes arg bytes of text; with dirty set, one byte in every 32 needs escaping.
+static void bench_escape_json(bench_state_t* state, int dirty)
+{
+    char* text = (char*)malloc(state->arg);
+    memcpy(text, bench_payload, state->arg);
+    if (dirty) {
+        for (size_t i = 31; i < state->arg; i += 32) {
+            text[i] = '"';
+        }
+    }
+    ccstring_view_t view = { text, state->arg };
+    ccstring_t* str = ccstring_new_empty(state->arg * 2);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        str->length = 0;
+        ccstring_append_json_escaped(&str, &view);
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&str);
+    free(text);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_escape_json_clean(bench_state_t* state)
+{
+    bench_escape_json(state, 0);
+}
+
+static void bench_escape_json_dirty(bench_state_t* state)
+{
+    bench_escape_json(state, 1);
+}
+
+static void bench_escape_csv_clean(bench_state_t* state)
+{
+    ccstring_view_t view = { bench_payload, state->arg };
+    ccstring_t* str = ccstring_new_empty(state->arg);
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        str->length = 0;
+        ccstring_append_csv_escaped(&str, &view, ',');
+    }
+    bench_pause(state);
+
+    ccstring_destroy(&str);
+    state->bytes_per_op = state->arg;
+}
+
+// One operation searches arg bytes of text that contain no match.
+static void bench_regex_search(bench_state_t* state, const char* pattern)
+{
+    ccstring_view_t source = { pattern, strlen(pattern) };
+    ccstring_regex_t* regex = ccstring_regex_new(&source);
+    ccstring_view_t text = { bench_payload, state->arg };
+    ccstring_slice_t match;
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        bench_sink += (size_t)ccstring_regex_search(regex, &text, &match);
+    }
+    bench_pause(state);
+
+    ccstring_regex_destroy(&regex);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_regex_prefix(bench_state_t* state)
+{
+    bench_regex_search(state, "ERROR (disk|net)[a-z]* \\d+ms");
+}
+
+static void bench_regex_automaton(bench_state_t* state)
+{
+    bench_regex_search(state, "[a-w]+ (disk|net)[a-z]* \\d+ms");
+}
+
+static void bench_glob(bench_state_t* state)
+{
+    ccstring_view_t pattern = { "*x?y*", 5 };
+    ccstring_view_t text = { bench_payload, state->arg };
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        bench_sink += (size_t)ccstring_glob_match(&pattern, &text);
+    }
+    bench_pause(state);
+    state->bytes_per_op = state->arg;
+}
+
+// One operation measures the distance between arg bytes of payload and a copy with every 16th byte changed.
+static void bench_levenshtein_run(bench_state_t* state, size_t max_distance)
+{
+    char* edited = (char*)malloc(state->arg);
+    if (!edited) {
+        return;
+    }
+    memcpy(edited, bench_payload, state->arg);
+    for (size_t i = 5; i < state->arg; i += 16) {
+        edited[i] = 'y';
+    }
+
+    ccstring_view_t a = { bench_payload, state->arg };
+    ccstring_view_t b = { edited, state->arg };
+    size_t distance;
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        ccstring_levenshtein_bounded(&a, &b, max_distance, &distance);
+        bench_sink += distance;
+    }
+    bench_pause(state);
+
+    free(edited);
+    state->bytes_per_op = state->arg;
+}
+
+static void bench_levenshtein(bench_state_t* state)
+{
+    bench_levenshtein_run(state, SIZE_MAX);
+}
+
+static void bench_levenshtein_bounded(bench_state_t* state)
+{
+    bench_levenshtein_run(state, 8);
+}
+
+// One operation looks up the 5 nearest of arg pseudo-random 6 to 13 byte words within distance 2.
+static void bench_manager_nearest(bench_state_t* state)
+{
+    ccstring_manager_t mgr = ccstring_manager_new(state->arg);
+    uint32_t seed = 12345;
+    char word[16];
+
+    for (size_t i = 0; i < state->arg; i++) {
+        seed = seed * 1103515245u + 12345u;
+        size_t length = 6 + (seed >> 16) % 8;
+        for (size_t j = 0; j < length; j++) {
+            seed = seed * 1103515245u + 12345u;
+            word[j] = (char)('a' + (seed >> 16) % 26);
+        }
+        ccstring_manager_add(&mgr, ccstring_new(word, length), 0);
+    }
+
+    ccstring_view_t query = { "levenshtein", 11 };
+    ccstring_fuzzy_match_t matches[5];
+    size_t count;
+
+    bench_resume(state);
+    for (size_t i = 0; i < state->iterations; i++) {
+        ccstring_manager_nearest(&mgr, &query, 2, matches, 5, &count);
+        bench_sink += count;
+    }
+    bench_pause(state);
+
+    ccstring_manager_destroy(&mgr);
+}
+
+size_t bench_accessors_inline(ccstring_t* const* strings, size_t count, size_t iterations);
+
+// Same loop as bench_accessors_inline, but through the exported ccstring_get / ccstring_length.
+static size_t bench_accessors_exported(ccstring_t* const* strings, size_t count, size_t iterations)
+{
+    size_t sum = 0;
+
+    for (size_t i = 0; i < iterations; i++) {
+        const ccstring_t* str = strings[i % count];
+        sum += ccstring_length(str) + (unsigned char)ccstring_get(str)[0];
+    }
+    return sum;
+}
+
+// One operation reads the length and first byte of a string; use_inline selects the loop built in bench_inline.c.
+static void bench_accessors(bench_state_t* state, int use_inline)
+{
+    ccstring_t* strings[64];
+    size_t count = sizeof(strings) / sizeof(strings[0]);
+
+    for (size_t i = 0; i < count; i++) {
+        strings[i] = ccstring_new(bench_payload, i + 1);
+    }
+
+    bench_resume(state);
+    if (use_inline) {
+        bench_sink += bench_accessors_inline(strings, count, state->iterations);
+    } else {
+        bench_sink += bench_accessors_exported(strings, count, state->iterations);
+    }
+    bench_pause(state);
+
+    for (size_t i = 0; i < count; i++) {
+        ccstring_destroy(&strings[i]);
+    }
+}
+
+static void bench_accessors_call(bench_state_t* state)
+{
+    bench_accessors(state, 0);
+}
+
+static void bench_accessors_header(bench_state_t* state)
+{
+    bench_accessors(state, 1);
+}
+
+static const bench_case_t bench_cases[] = {
+    { "construct/new/8", bench_new, 8 },
+    { "construct/new/64", bench_new, 64 },
+    { "construct/new/1024", bench_new, 1024 },
+    { "construct/new/65536", bench_new, 65536 },
+    { "construct/auto/8", bench_auto, 8 },
+    { "construct/auto/1024", bench_auto, 1024 },
+    { "construct/from_view/64", bench_new_from_view, 64 },
+    { "construct/from_view/65536", bench_new_from_view, 65536 },
+    { "append/1", bench_append, 1 },
+    { "append/16", bench_append, 16 },
+    { "append/256", bench_append, 256 },
+    { "copy/64", bench_copy, 64 },
+    { "copy/1024", bench_copy, 1024 },
+    { "copy/65536", bench_copy, 65536 },
+    { "view/new/64", bench_view, 64 },
+    { "slice/new/64", bench_slice, 64 },
+    { "compare/equal/8", bench_compare_equal, 8 },
+    { "compare/equal/64", bench_compare_equal, 64 },
+    { "compare/equal/1024", bench_compare_equal, 1024 },
+    { "compare/equal/65536", bench_compare_equal, 65536 },
+    { "compare/last_byte/64", bench_compare_last_byte, 64 },
+    { "compare/last_byte/65536", bench_compare_last_byte, 65536 },
+    { "manager/add/16", bench_manager_add, 16 },
+    { "manager/add/1024", bench_manager_add, 1024 },
+    { "manager/add/16384", bench_manager_add, 16384 },
+    { "manager/remove_front/16", bench_manager_remove, 16 },
+    { "manager/remove_front/1024", bench_manager_remove, 1024 },
+    { "manager/remove_front/16384", bench_manager_remove, 16384 },
+    { "encode/hex/64", bench_encode_hex, 64 },
+    { "encode/hex/65536", bench_encode_hex, 65536 },
+    { "decode/hex/65536", bench_decode_hex, 65536 },
+    { "encode/base64/64", bench_encode_base64, 64 },
+    { "encode/base64/65536", bench_encode_base64, 65536 },
+    { "decode/base64/65536", bench_decode_base64, 65536 },
+    { "escape/json/clean/64", bench_escape_json_clean, 64 },
+    { "escape/json/clean/65536", bench_escape_json_clean, 65536 },
+    { "escape/json/dirty/65536", bench_escape_json_dirty, 65536 },
+    { "escape/csv/clean/65536", bench_escape_csv_clean, 65536 },
+    { "regex/search/prefix/65536", bench_regex_prefix, 65536 },
+    { "regex/search/automaton/65536", bench_regex_automaton, 65536 },
+    { "glob/match/1024", bench_glob, 1024 },
+    { "levenshtein/myers/32", bench_levenshtein, 32 },
+    { "levenshtein/banded/1024", bench_levenshtein, 1024 },
+    { "levenshtein/bounded/1024", bench_levenshtein_bounded, 1024 },
+    { "nearest/manager/1024", bench_manager_nearest, 1024 },
+    { "nearest/manager/16384", bench_manager_nearest, 16384 },
+    { "accessors/exported", bench_accessors_call, 0 },
+    { "accessors/inline", bench_accessors_header, 0 },
+};
+
+// Grows the iteration count like Google Benchmark until one run lasts at least min_time_ns.
+static bench_result_t bench_run(const bench_case_t* bench, double min_time_ns)
+{
+    bench_result_t result;
+    bench_state_t state;
+    size_t iterations = 1;
+
+    for (;;) {
+        memset(&state, 0, sizeof(state));
+        state.iterations = iterations;
+        state.arg = bench->arg;
+        bench->fn(&state);
+
+        if (state.elapsed_ns >= min_time_ns || iterations >= BENCH_MAX_ITERATIONS) {
+            break;
+        }
+
+        double scale = state.elapsed_ns > 0.0 ? min_time_ns * 1.4 / state.elapsed_ns : 100.0;
+        if (scale > 100.0) {
+            scale = 100.0;
+        }
+        size_t next = (size_t)((double)iterations * scale);
+        iterations = next > iterations ? next : iterations + 1;
+        if (iterations > BENCH_MAX_ITERATIONS) {
+            iterations = BENCH_MAX_ITERATIONS;
+        }
+    }
+
+    memset(&result, 0, sizeof(result));
+    snprintf(result.name, sizeof(result.name), "%s", bench->name);
+    result.iterations = state.iterations;
+    result.ns_per_op = state.elapsed_ns / (double)state.iterations;
+    result.allocs_per_op = (double)state.allocations / (double)state.iterations;
+    if (state.bytes_per_op > 0 && state.elapsed_ns > 0.0) {
+        result.bytes_per_second = (double)state.bytes_per_op * (double)state.iterations * 1e9 / state.elapsed_ns;
+    }
+    return result;
+}
+
+static void bench_format_rate(char* out, size_t size, double bytes_per_second)
+{
+    static const char* units[] = { "B/s", "KiB/s", "MiB/s", "GiB/s", "TiB/s" };
+    size_t unit = 0;
+
+    if (bytes_per_second <= 0.0) {
+        snprintf(out, size, "-");
+        return;
+    }
+    while (bytes_per_second >= 1024.0 && unit < 4) {
+        bytes_per_second /= 1024.0;
+        unit++;
+    }
+    snprintf(out, size, "%.2f %s", bytes_per_second, units[unit]);
+}
+
+static void bench_print_table_header(void)
+{
+    printf("%-32s %14s %14s %14s %12s\n", "Benchmark", "Time", "Iterations", "Bytes/s", "Allocs/op");
+    printf("--------------------------------------------------------------------------------------------\n");
+}
+
+static void bench_print_table_row(const bench_result_t* result)
+{
+    char rate[32];
+    char allocs[32];
+    bench_format_rate(rate, sizeof(rate), result->bytes_per_second);
+    if (bench_stats_enabled) {
+        snprintf(allocs, sizeof(allocs), "%.2f", result->allocs_per_op);
+    } else {
+        snprintf(allocs, sizeof(allocs), "-");
+    }
+    printf("%-32s %11.2f ns %14zu %14s %12s\n", result->name, result->ns_per_op, result->iterations, rate, allocs);
+}
+
+static void bench_print_json(const bench_result_t* results, size_t count)
+{
+    char date[32] = "";
+    time_t now = time(NULL);
+    struct tm* utc = gmtime(&now);
+    if (utc) {
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", utc);
+    }
+
+    printf("{\n");
+    printf("  \"context\": {\n");
+    printf("    \"date\": \"%s\",\n", date);
+    printf("    \"library\": \"ccstring\",\n");
+    printf("    \"library_version\": \"%d.%d.%d\"\n", CCSTRING_VERSION_MAJOR, CCSTRING_VERSION_MINOR, CCSTRING_VERSION_PATCH);
+    printf("  },\n");
+    printf("  \"benchmarks\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        printf("    {\n");
+        printf("      \"name\": \"%s\",\n", results[i].name);
+        printf("      \"iterations\": %zu,\n", results[i].iterations);
+        printf("      \"real_time\": %.4f,\n", results[i].ns_per_op);
+        printf("      \"time_unit\": \"ns\",\n");
+        if (bench_stats_enabled) {
+            printf("      \"bytes_per_second\": %.2f,\n", results[i].bytes_per_second);
+            printf("      \"allocs_per_op\": %.4f\n", results[i].allocs_per_op);
+        } else {
+            printf("      \"bytes_per_second\": %.2f\n", results[i].bytes_per_second);
+        }
+        printf("    }%s\n", i + 1 < count ? "," : "");
+    }
+    printf("  ]\n");
+    printf("}\n");
+}
+
+static void bench_usage(const char* program)
+{
+    printf("Usage: %s [--json] [--filter=SUBSTRING] [--min-time=SECONDS] [--list]\n", program);
+}
+
+int main(int argc, char** argv)
+{
+    const size_t case_count = sizeof(bench_cases) / sizeof(bench_cases[0]);
+    const char* filter = NULL;
+    double min_time = 0.1;
+    int json = 0;
+    int list = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = 1;
+        } else if (strcmp(argv[i], "--list") == 0) {
+            list = 1;
+        } else if (strncmp(argv[i], "--filter=", 9) == 0) {
+            filter = argv[i] + 9;
+        } else if (strncmp(argv[i], "--min-time=", 11) == 0) {
+            min_time = atof(argv[i] + 11);
+        } else {
+            bench_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (list) {
+        for (size_t i = 0; i < case_count; i++) {
+            printf("%s\n", bench_cases[i].name);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    memset(bench_payload, 'x', BENCH_PAYLOAD_SIZE);
+    bench_payload[BENCH_PAYLOAD_SIZE] = '\0';
+
+    // Allocations/op needs a library built with CCSTRING_ENABLE_STATS; otherwise it is reported as "-".
+    ccstring_stats_t stats;
+    bench_stats_enabled = ccstring_stats_snapshot(&stats) == 0;
+
+    bench_result_t* results = (bench_result_t*)malloc(case_count * sizeof(*results));
+    size_t result_count = 0;
+    if (!results) {
+        return EXIT_FAILURE;
+    }
+
+    if (!json) {
+        bench_print_table_header();
+    }
+
+    for (size_t i = 0; i < case_count; i++) {
+        if (filter && strstr(bench_cases[i].name, filter) == NULL) {
+            continue;
+        }
+
+        results[result_count] = bench_run(&bench_cases[i], min_time * 1e9);
+        if (!json) {
+            bench_print_table_row(&results[result_count]);
+            fflush(stdout);
+        }
+        result_count++;
+    }
+
+    if (json) {
+        bench_print_json(results, result_count);
+    }
+
+    free(results);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,18 @@
+// Compiled with CCSTRING_INLINE_ACCESSORS so the accessor benchmarks can compare the header-inline
+// accessors against the exported functions used by bench.c.
+#ifndef CCSTRING_INLINE_ACCESSORS
+    #define CCSTRING_INLINE_ACCESSORS
+#endif
+
+#include "ccstring.h"
+
+size_t bench_accessors_inline(ccstring_t* const* strings, size_t count, size_t iterations)
+{
+    size_t sum = 0;
+
+    for (size_t i = 0; i < iterations; i++) {
+        const ccstring_t* str = strings[i % count];
+        sum += ccstring_length(str) + (unsigned char)ccstring_get(str)[0];
+    }
+    return sum;
+}
@@ -1,7 +1,7 @@
 /**
  * @file ccstring.h
  * @brief C string manipulation library header file in eay to use containers.
- * @version 1.0.0
+ * @version 2.0.0
  * @date 2025-04-11 
 */
 
@@ -14,7 +14,7 @@
 
     /**
      * @brief C string manipulation library header file in easy to use containers.
-     * @version 1.0.0
+     * @version 2.0.0
      * @date 2025-04-11 
     */
 
@@ -51,18 +51,51 @@
     /**
      * Project Version
     */
-    #define CCSTRING_VERSION 1.0
-    #define CCSTRING_VERSION_MAJOR 1
+    #define CCSTRING_VERSION 2.0
+    #define CCSTRING_VERSION_MAJOR 2
     #define CCSTRING_VERSION_MINOR 0
-    #define CCSTRING_VERSION_PATCH 2
+    #define CCSTRING_VERSION_PATCH 0
 
     #include <stddef.h>
 
+    /**
+     * Storage flags of a ccstring_t. Strings from ccstring_new and friends have no flags set.
+     * CCSTRING_FLAG_STATIC: the ccstring_t itself is not heap allocated and is never freed.
+     * CCSTRING_FLAG_BORROWED: the buffer is not owned by the string; growing moves the contents to the heap.
+     * CCSTRING_FLAG_READONLY: the contents cannot be modified; every mutating call fails.
+    */
+    #define CCSTRING_FLAG_STATIC 1u
+    #define CCSTRING_FLAG_BORROWED 2u
+    #define CCSTRING_FLAG_READONLY 4u
+
     typedef struct ccstring {
         char* buffer;
         size_t length;
         size_t capacity;
+        unsigned int flags;
     } ccstring_t;
+
+    /**
+     * Initializer for a read-only ccstring_t that refers to a string literal without allocating.
+     * Usable for static objects: static const ccstring_t greeting = CCSTRING_LITERAL_INIT("hello");
+    */
+    #define CCSTRING_LITERAL_INIT(text) \
+        { (char*)("" text), sizeof("" text) - 1, sizeof("" text), CCSTRING_FLAG_STATIC | CCSTRING_FLAG_BORROWED | CCSTRING_FLAG_READONLY }
+
+    /**
+     * Pointer to a read-only ccstring_t literal with the length computed at compile time.
+     * The object has the storage duration of the enclosing block, or static storage at file scope.
+    */
+    #define CCSTRING_LITERAL(text) (&(ccstring_t)CCSTRING_LITERAL_INIT(text))
+
+    /**
+     * Declare a string named name backed by a stack buffer of size bytes (including the null terminator).
+     * The string spills to the heap only when it outgrows the buffer; release it with ccstring_destroy(&name).
+    */
+    #define CCSTRING_STACK(name, size) \
+        char name##_storage[(size)]; \
+        ccstring_t name##_header = ccstring_stack(name##_storage, sizeof(name##_storage)); \
+        ccstring_t* name = &name##_header
     
     typedef struct ccstring_view {
         const char* buffer;
@@ -74,12 +107,87 @@
         size_t length;
     } ccstring_slice_t;
 
+    typedef struct ccstring_split {
+        const char* cursor;
+        const char* end;
+        const char* delimiter;
+        size_t delimiter_length;
+        int done;
+    } ccstring_split_t;
+
     typedef struct ccstring_manager {
         ccstring_t** list;
         size_t count;
         size_t capacity; 
     } ccstring_manager_t;
 
+    typedef struct ccstring_table {
+        char* data;
+        size_t data_length;
+        size_t data_capacity;
+        void* offsets;
+        size_t count;
+        size_t capacity;
+        unsigned int offset_width;
+        int frozen;
+        const void* hash_index;
+        size_t hash_buckets;
+        unsigned int hash_width;
+        void* mapping;
+        size_t mapping_size;
+    } ccstring_table_t;
+
+    typedef struct ccstring_radix {
+        void* root;
+        ccstring_manager_t* mgr;
+        size_t count;
+    } ccstring_radix_t;
+
+    /**
+     * Callback used by ccstring_radix_iterate_prefix. Return 0 to continue, non-zero to stop the iteration.
+    */
+    typedef int (*ccstring_radix_visit_fn)(const ccstring_view_t* key, void* value, void* context);
+
+    /**
+     * Number of log2 buckets in the statistics histograms. Bucket 0 counts zero, bucket i counts values in
+     * [2^(i-1), 2^i - 1] and the last bucket collects everything larger.
+    */
+    #define CCSTRING_STATS_BUCKETS 24
+
+    typedef struct ccstring_stats {
+        size_t allocations;
+        size_t reallocations;
+        size_t frees;
+        size_t bytes_allocated;
+        size_t bytes_copied;
+        size_t strings_destroyed;
+        size_t length_histogram[CCSTRING_STATS_BUCKETS];
+        size_t slack_histogram[CCSTRING_STATS_BUCKETS];
+        size_t manager_growths;
+        size_t manager_peak_count;
+    } ccstring_stats_t;
+
+    /**
+     * @brief Copy the statistics counters of the calling thread.
+     * Counters are only maintained when the library is built with CCSTRING_ENABLE_STATS; otherwise every
+     * counting site compiles away. Length and slack (capacity minus length) histograms are recorded when a
+     * string is destroyed.
+     * @param out Output structure that receives the counters. Zeroed when statistics are disabled.
+     * @return 0 on success, non-zero if statistics are disabled.
+     */
+    CCSTRING_API int ccstring_stats_snapshot(ccstring_stats_t* out);
+
+    /**
+     * @brief Reset the statistics counters of the calling thread.
+     */
+    CCSTRING_API void ccstring_stats_reset(void);
+
+    /**
+     * @brief Print the statistics counters of the calling thread in a human readable form.
+     * @param stream The FILE* to write to. It is taken as void* so this header does not pull in <stdio.h>.
+     */
+    CCSTRING_API void ccstring_stats_dump(void* stream);
+
     /**
      * @brief Create a new ccstring_t object from a C string.
      * @param str The C string to copy into the new ccstring_t object.
@@ -125,6 +233,43 @@
      */
      CCSTRING_API ccstring_t* ccstring_new_empty(size_t size);
 
+    /**
+     * @brief Initialize a ccstring_t that uses a caller-provided buffer as its storage.
+     * The returned object is not heap allocated; ccstring_destroy only frees the heap buffer it may have
+     * spilled into after outgrowing buffer.
+     * @param buffer The storage to use. Must outlive the string.
+     * @param buffer_size The size of buffer in bytes, including the null terminator.
+     * @return The initialized, empty string.
+     */
+    CCSTRING_API ccstring_t ccstring_stack(char* buffer, size_t buffer_size);
+
+    /**
+     * Defining CCSTRING_INLINE_ACCESSORS before including this header (or configuring with
+     * -DCCSTRING_INLINE_ACCESSORS=ON) turns the accessors below into static inline functions, so reading a field
+     * costs no call through the PLT or import table. The library still exports them for existing binaries.
+    */
+    #if defined(CCSTRING_INLINE_ACCESSORS) && !defined(CCSTRING_BUILDING)
+
+    static inline const char* ccstring_get(const ccstring_t* str)
+    {
+        return str->buffer;
+    }
+
+    static inline size_t ccstring_length(const ccstring_t* str)
+    {
+        return str->length;
+    }
+
+    static inline ccstring_view_t ccstring_view_of(const ccstring_t* str)
+    {
+        ccstring_view_t view;
+        view.buffer = str->buffer;
+        view.length = str->length;
+        return view;
+    }
+
+    #else
+
     /**
      * @brief Get the internal C string (null-terminated) from a ccstring_t object.
      * @param str The ccstring_t object.
@@ -139,6 +284,16 @@
      */
     CCSTRING_API size_t ccstring_length(const ccstring_t* str);
 
+    /**
+     * @brief Get a view of a ccstring_t by value, without allocating.
+     * The view is invalidated by any call that reallocates the string.
+     * @param str The ccstring_t object to view.
+     * @return A view over the whole string.
+     */
+    CCSTRING_API ccstring_view_t ccstring_view_of(const ccstring_t* str);
+
+    #endif
+
     /**
      * @brief Create a ccstring_view_t object representing a view into a ccstring_t.
      * @param str The ccstring_t object to view.
@@ -155,6 +310,24 @@
      */
     CCSTRING_API ccstring_slice_t* ccstring_slice_new(ccstring_t* str, size_t start, size_t end);
 
+    /**
+     * @brief Start splitting a view on a delimiter without allocating.
+     * Adjacent delimiters produce empty tokens, and an empty view produces a single empty token.
+     * @param view The view to split. Its buffer must outlive the iterator.
+     * @param delimiter The delimiter bytes. Must outlive the iterator.
+     * @param delimiter_length The delimiter length. An empty delimiter yields the whole view as one token.
+     * @return The iterator state, positioned before the first token.
+     */
+    CCSTRING_API ccstring_split_t ccstring_split_new(const ccstring_view_t* view, const char* delimiter, size_t delimiter_length);
+
+    /**
+     * @brief Advance a split iterator to the next token.
+     * @param split The iterator state.
+     * @param out_slice Output slice that receives the token. It points into the split view.
+     * @return 0 if a token was produced, non-zero once the input is exhausted.
+     */
+    CCSTRING_API int ccstring_split_next(ccstring_split_t* split, ccstring_slice_t* out_slice);
+
     /**
      * @brief Resize the internal buffer of a ccstring_t.
      * @param str A pointer to the ccstring_t object pointer to resize.
@@ -207,6 +380,7 @@
 
     /**
      * @brief Free the memory used by a ccstring_t object and set the pointer to NULL.
+     * Literal and stack-backed strings only release the heap memory they own.
      * @param str A pointer to the ccstring_t object pointer to destroy.
      * @return The number of bytes freed.
      */
@@ -255,6 +429,372 @@
      */
     CCSTRING_API void ccstring_manager_destroy(ccstring_manager_t* mgr);
 
+    /**
+     * Sort flags accepted by ccstring_sort, ccstring_view_sort and ccstring_manager_sort.
+     * CCSTRING_SORT_STABLE keeps equal strings in their original relative order.
+     * CCSTRING_SORT_PARALLEL spreads large inputs across all available CPU cores.
+    */
+    #define CCSTRING_SORT_DEFAULT 0
+    #define CCSTRING_SORT_STABLE 1
+    #define CCSTRING_SORT_PARALLEL 2
+
+    /**
+     * @brief Sort an array of ccstring_t pointers in ascending byte order.
+     * Strings are ordered by memcmp over their contents; a string sorts before any longer string it prefixes.
+     * @param list The array of strings to sort in place. Entries must not be NULL.
+     * @param count The number of entries in the array.
+     * @param flags A combination of the CCSTRING_SORT_* flags.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_sort(ccstring_t** list, size_t count, int flags);
+
+    /**
+     * @brief Sort an array of ccstring_view_t objects in ascending byte order.
+     * @param views The array of views to sort in place.
+     * @param count The number of entries in the array.
+     * @param flags A combination of the CCSTRING_SORT_* flags.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_view_sort(ccstring_view_t* views, size_t count, int flags);
+
+    /**
+     * @brief Sort the strings owned by a manager in ascending byte order.
+     * @param mgr The manager whose list is reordered.
+     * @param flags A combination of the CCSTRING_SORT_* flags.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_manager_sort(ccstring_manager_t* mgr, int flags);
+
+    /**
+     * @brief Create a new packed string table.
+     * Entries are stored back to back (each null-terminated) in one buffer and located through an offset array
+     * that uses 32-bit offsets until the data outgrows them.
+     * @param initial_count The number of entries to reserve room for.
+     * @param initial_bytes The number of data bytes to reserve, excluding null terminators.
+     * @return The new table. data and offsets are NULL if allocation failed.
+     */
+    CCSTRING_API ccstring_table_t ccstring_table_new(size_t initial_count, size_t initial_bytes);
+
+    /**
+     * @brief Append a copy of a buffer to the end of the table.
+     * @param table The table to append to. Must not be frozen.
+     * @param str The bytes to copy.
+     * @param size The number of bytes to copy.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_table_append(ccstring_table_t* table, const char* str, size_t size);
+
+    /**
+     * @brief Append a copy of every string owned by a manager, in list order.
+     * @param table The table to append to. Must not be frozen.
+     * @param mgr The manager to copy from. The manager keeps ownership of its strings.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_table_append_manager(ccstring_table_t* table, const ccstring_manager_t* mgr);
+
+    /**
+     * @brief Release spare capacity and make the table read-only.
+     * @param table The table to freeze.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_table_freeze(ccstring_table_t* table);
+
+    /**
+     * @brief Get a view of one table entry.
+     * @param table The table to read from.
+     * @param index The index of the entry.
+     * @return A view into the table data, or an empty view with a NULL buffer if index is out of range.
+     */
+    CCSTRING_API ccstring_view_t ccstring_table_get(const ccstring_table_t* table, size_t index);
+
+    /**
+     * @brief Find the index of an entry equal to the given bytes.
+     * Uses the hash index of a mapped table when present and falls back to a linear scan otherwise.
+     * @param table The table to search.
+     * @param str The bytes to look for.
+     * @param size The number of bytes to compare.
+     * @param out_index Output pointer that receives the index of the first matching entry.
+     * @return 0 if found, non-zero otherwise.
+     */
+    CCSTRING_API int ccstring_table_find(const ccstring_table_t* table, const char* str, size_t size, size_t* out_index);
+
+    /**
+     * Flags accepted by ccstring_table_write and ccstring_manager_write.
+     * CCSTRING_TABLE_HASH_INDEX stores an open addressing hash index used by ccstring_table_find.
+    */
+    #define CCSTRING_TABLE_DEFAULT 0
+    #define CCSTRING_TABLE_HASH_INDEX 1
+
+    /**
+     * File format version written by ccstring_table_write.
+    */
+    #define CCSTRING_TABLE_FORMAT_VERSION 1
+
+    /**
+     * @brief Write a table to disk in the ccstring table file format.
+     * The file holds a fixed header, the offset array, the data blob and an optional hash index, laid out so it
+     * can be memory mapped and used without parsing. The format uses the byte order of the writing machine.
+     * @param table The table to write.
+     * @param path The path of the file to create or overwrite.
+     * @param flags A combination of the CCSTRING_TABLE_* flags.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_table_write(const ccstring_table_t* table, const char* path, int flags);
+
+    /**
+     * @brief Write the strings owned by a manager to disk in the ccstring table file format.
+     * @param mgr The manager to write. The manager keeps ownership of its strings.
+     * @param path The path of the file to create or overwrite.
+     * @param flags A combination of the CCSTRING_TABLE_* flags.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_manager_write(const ccstring_manager_t* mgr, const char* path, int flags);
+
+    /**
+     * @brief Open a table file by memory mapping it read-only.
+     * Views returned by ccstring_table_get point into the mapping and stay valid until ccstring_table_destroy.
+     * Only the header and section bounds are validated, so the file must come from a trusted writer.
+     * @param table Output table. It is frozen and must be released with ccstring_table_destroy.
+     * @param path The path of the file to map.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_table_map(ccstring_table_t* table, const char* path);
+
+    /**
+     * @brief Release the table buffers, or unmap the file of a mapped table.
+     * @param table The table to destroy.
+     */
+    CCSTRING_API void ccstring_table_destroy(ccstring_table_t* table);
+
+    /**
+     * @brief Create a new radix tree keyed by byte strings.
+     * Inner nodes adapt between 4, 16, 48 and 256 children and store compressed path prefixes.
+     * @param mgr Optional manager that takes ownership of a copy of every inserted key. When NULL the tree
+     * references the caller's key bytes, which must outlive the tree.
+     * @return The new, empty tree.
+     */
+    CCSTRING_API ccstring_radix_t ccstring_radix_new(ccstring_manager_t* mgr);
+
+    /**
+     * @brief Insert a key or replace the value of an existing key.
+     * @param tree The tree to insert into.
+     * @param key The key to insert.
+     * @param value The value to associate with the key.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_radix_insert(ccstring_radix_t* tree, const ccstring_view_t* key, void* value);
+
+    /**
+     * @brief Look up the value stored for an exact key.
+     * @param tree The tree to search.
+     * @param key The key to look for.
+     * @param out_value Output pointer that receives the value. May be NULL.
+     * @return 0 if found, non-zero otherwise.
+     */
+    CCSTRING_API int ccstring_radix_find(const ccstring_radix_t* tree, const ccstring_view_t* key, void** out_value);
+
+    /**
+     * @brief Find the longest stored key that is a prefix of the given key.
+     * @param tree The tree to search.
+     * @param key The key to match against.
+     * @param out_key Output view that receives the matched stored key. May be NULL.
+     * @param out_value Output pointer that receives the value. May be NULL.
+     * @return 0 if a prefix was found, non-zero otherwise.
+     */
+    CCSTRING_API int ccstring_radix_longest_prefix(const ccstring_radix_t* tree, const ccstring_view_t* key, ccstring_view_t* out_key, void** out_value);
+
+    /**
+     * @brief Visit every stored key that starts with a prefix, in ascending byte order.
+     * @param tree The tree to iterate.
+     * @param prefix The prefix to match. An empty prefix visits every key.
+     * @param visit The callback invoked for each key.
+     * @param context Caller data passed to the callback.
+     * @return 0 when the iteration completed, otherwise the non-zero value returned by the callback.
+     */
+    CCSTRING_API int ccstring_radix_iterate_prefix(const ccstring_radix_t* tree, const ccstring_view_t* prefix, ccstring_radix_visit_fn visit, void* context);
+
+    /**
+     * @brief Free all nodes of a radix tree. Keys owned through the manager stay with the manager.
+     * @param tree The tree to destroy.
+     */
+    CCSTRING_API void ccstring_radix_destroy(ccstring_radix_t* tree);
+
+    /**
+     * Flags accepted by ccstring_append_hex.
+     * CCSTRING_HEX_UPPERCASE emits A-F instead of a-f. The decoder accepts both cases.
+    */
+    #define CCSTRING_HEX_LOWERCASE 0
+    #define CCSTRING_HEX_UPPERCASE 1
+
+    /**
+     * @brief Append the hexadecimal encoding of a binary buffer (two characters per byte).
+     * @param str A pointer to the ccstring_t object pointer.
+     * @param data The bytes to encode.
+     * @param size The number of bytes to encode.
+     * @param flags CCSTRING_HEX_LOWERCASE or CCSTRING_HEX_UPPERCASE.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_append_hex(ccstring_t** str, const void* data, size_t size, int flags);
+
+    /**
+     * @brief Decode hexadecimal text and append the resulting bytes.
+     * @param str A pointer to the ccstring_t object pointer.
+     * @param text The hexadecimal text. Its length must be even.
+     * @return 0 on success, non-zero on failure or invalid input, in which case the contents of str are unchanged.
+     */
+    CCSTRING_API int ccstring_append_hex_decoded(ccstring_t** str, const ccstring_view_t* text);
+
+    /**
+     * @brief Append the padded base64 encoding (RFC 4648 standard alphabet) of a binary buffer.
+     * @param str A pointer to the ccstring_t object pointer.
+     * @param data The bytes to encode.
+     * @param size The number of bytes to encode.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_append_base64(ccstring_t** str, const void* data, size_t size);
+
+    /**
+     * @brief Decode base64 text (RFC 4648 standard alphabet) and append the resulting bytes.
+     * Padding is optional; whitespace and any other byte outside the alphabet is rejected.
+     * @param str A pointer to the ccstring_t object pointer.
+     * @param text The base64 text.
+     * @return 0 on success, non-zero on failure or invalid input, in which case the contents of str are unchanged.
+     */
+    CCSTRING_API int ccstring_append_base64_decoded(ccstring_t** str, const ccstring_view_t* text);
+
+    /**
+     * @brief Append text escaped for use inside a JSON string literal (without the surrounding quotes).
+     * Quotes, backslashes and control characters are escaped; every other byte, including UTF-8, is copied as is.
+     * @param str A pointer to the ccstring_t object pointer.
+     * @param text The text to escape.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_append_json_escaped(ccstring_t** str, const ccstring_view_t* text);
+
+    /**
+     * @brief Decode the contents of a JSON string literal (without the surrounding quotes) and append the result.
+     * \uXXXX escapes, including surrogate pairs, are written as UTF-8.
+     * @param str A pointer to the ccstring_t object pointer.
+     * @param text The escaped text.
+     * @return 0 on success, non-zero on failure or invalid input, in which case the contents of str are unchanged.
+     */
+    CCSTRING_API int ccstring_append_json_unescaped(ccstring_t** str, const ccstring_view_t* text);
+
+    /**
+     * @brief Append a field escaped as described by RFC 4180.
+     * A field containing the delimiter, a quote, CR or LF is wrapped in quotes, with inner quotes doubled.
+     * Any other field is copied as is.
+     * @param str A pointer to the ccstring_t object pointer.
+     * @param field The field to escape.
+     * @param delimiter The field delimiter, usually ','.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_append_csv_escaped(ccstring_t** str, const ccstring_view_t* field, char delimiter);
+
+    /**
+     * @brief Decode one CSV field and append the result.
+     * A quoted field loses its surrounding quotes and has doubled quotes collapsed; any other field is copied as is.
+     * @param str A pointer to the ccstring_t object pointer.
+     * @param field The field as it appears in the CSV text.
+     * @return 0 on success, non-zero on failure or invalid input, in which case the contents of str are unchanged.
+     */
+    CCSTRING_API int ccstring_append_csv_unescaped(ccstring_t** str, const ccstring_view_t* field);
+
+    /**
+     * Compiled regular expression. See ccstring_regex_new for the supported syntax.
+    */
+    typedef struct ccstring_regex ccstring_regex_t;
+
+    /**
+     * @brief Match text against a glob pattern.
+     * Supports * (any run of bytes), ? (any one byte), [abc], [a-z], [!abc] or [^abc], and \ to escape the next byte.
+     * The whole text must match. No memory is allocated.
+     * @param pattern The glob pattern.
+     * @param text The text to match.
+     * @return 0 if the text matches, non-zero otherwise.
+     */
+    CCSTRING_API int ccstring_glob_match(const ccstring_view_t* pattern, const ccstring_view_t* text);
+
+    /**
+     * @brief Compile a regular expression into a bit-parallel automaton that matches in linear time.
+     * Supported syntax: literals, . (any byte except newline), [...] and [^...] classes with ranges,
+     * \d \w \s \D \W \S \n \r \t \f \v and escaped punctuation, grouping with ( ), alternation with |,
+     * and the quantifiers * + ?. A top-level alternative may begin with ^ and end with $; the anchor applies to
+     * that alternative only, so ^a|b matches a at the start of the text or b anywhere. Anchors inside groups
+     * are rejected.
+     * Counted repetition and backreferences are not supported.
+     * @param pattern The pattern. At most 64 literal or class positions are allowed.
+     * @return The compiled expression, or NULL if the pattern is invalid, too large, or allocation fails.
+     */
+    CCSTRING_API ccstring_regex_t* ccstring_regex_new(const ccstring_view_t* pattern);
+
+    /**
+     * @brief Check whether the whole text matches a compiled expression. Does not allocate.
+     * @param regex The compiled expression.
+     * @param text The text to match.
+     * @return 0 if the text matches, non-zero otherwise.
+     */
+    CCSTRING_API int ccstring_regex_match(const ccstring_regex_t* regex, const ccstring_view_t* text);
+
+    /**
+     * @brief Find the leftmost-longest match of a compiled expression in text. Does not allocate.
+     * @param regex The compiled expression.
+     * @param text The text to search.
+     * @param out_match Receives the matched span inside text. May be NULL when only a yes/no answer is needed,
+     * which takes a single forward pass.
+     * @return 0 if a match was found, non-zero otherwise.
+     */
+    CCSTRING_API int ccstring_regex_search(const ccstring_regex_t* regex, const ccstring_view_t* text, ccstring_slice_t* out_match);
+
+    /**
+     * @brief Free a compiled expression and set the pointer to NULL.
+     * @param regex A pointer to the compiled expression pointer.
+     */
+    CCSTRING_API void ccstring_regex_destroy(ccstring_regex_t** regex);
+
+    /**
+     * One result of ccstring_manager_nearest: the position of a string in the manager list and its edit distance.
+    */
+    typedef struct ccstring_fuzzy_match {
+        size_t index;
+        size_t distance;
+    } ccstring_fuzzy_match_t;
+
+    /**
+     * @brief Compute the Levenshtein edit distance between two byte strings.
+     * Strings of up to 64 bytes after trimming the common prefix and suffix use the bit-parallel Myers algorithm;
+     * longer pairs use a banded dynamic program whose band widens until it covers the answer.
+     * @param a The first string.
+     * @param b The second string.
+     * @param out_distance Receives the number of single-byte insertions, deletions and substitutions.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_levenshtein(const ccstring_view_t* a, const ccstring_view_t* b, size_t* out_distance);
+
+    /**
+     * @brief Compute the Levenshtein distance, giving up as soon as it is known to exceed max_distance.
+     * Much cheaper than ccstring_levenshtein when most pairs are far apart.
+     * @param a The first string.
+     * @param b The second string.
+     * @param max_distance The largest distance of interest.
+     * @param out_distance Receives the distance, or max_distance + 1 when the distance is larger than max_distance.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_levenshtein_bounded(const ccstring_view_t* a, const ccstring_view_t* b, size_t max_distance, size_t* out_distance);
+
+    /**
+     * @brief Find the strings in a manager closest to a query by edit distance.
+     * Large managers are scanned on all available CPU cores. Each scan tightens its bound as its best matches improve.
+     * @param mgr The manager to search. Its strings are only read.
+     * @param query The string to look up.
+     * @param max_distance Strings farther than this are never reported.
+     * @param out_matches Receives up to k matches ordered by distance, ties broken by list position.
+     * @param k The capacity of out_matches.
+     * @param out_count Receives the number of matches written.
+     * @return 0 on success, non-zero on failure.
+     */
+    CCSTRING_API int ccstring_manager_nearest(const ccstring_manager_t* mgr, const ccstring_view_t* query, size_t max_distance, ccstring_fuzzy_match_t* out_matches, size_t k, size_t* out_count);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -0,0 +1,273 @@
+/**
+ * @file ccstring.hpp
+ * @brief Header-only C++17 wrapper over the ccstring C API.
+ * @version 2.0.0
+ * @date 2025-04-11
+*/
+
+#ifndef __CCSTRING_HPP__
+#define __CCSTRING_HPP__
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "ccstring.h"
+
+namespace cc {
+
+    /**
+     * @brief Non-owning wrapper over ccstring_view_t or ccstring_slice_t.
+     * Converts to and from std::string_view without copying.
+    */
+    template <typename CView>
+    class basic_view {
+    public:
+        using const_iterator = const char*;
+
+        constexpr basic_view() noexcept : view_{ nullptr, 0 } {}
+        constexpr basic_view(std::string_view text) noexcept : view_{ text.data(), text.size() } {}
+        constexpr basic_view(const char* buffer, std::size_t length) noexcept : view_{ buffer, length } {}
+        constexpr basic_view(const ccstring_view_t& view) noexcept : view_{ view.buffer, view.length } {}
+        constexpr basic_view(const ccstring_slice_t& slice) noexcept : view_{ slice.buffer, slice.length } {}
+
+        constexpr const char* data() const noexcept { return view_.buffer; }
+        constexpr std::size_t size() const noexcept { return view_.length; }
+        constexpr bool empty() const noexcept { return view_.length == 0; }
+
+        constexpr const_iterator begin() const noexcept { return view_.buffer; }
+        constexpr const_iterator end() const noexcept { return view_.buffer + view_.length; }
+
+        constexpr operator std::string_view() const noexcept { return std::string_view(view_.buffer, view_.length); }
+
+        /**
+         * @brief Access the underlying C object, e.g. to pass it to the C API.
+         */
+        constexpr const CView* c_view() const noexcept { return &view_; }
+
+        friend constexpr bool operator==(basic_view a, basic_view b) noexcept
+        {
+            return std::string_view(a) == std::string_view(b);
+        }
+
+        friend constexpr bool operator!=(basic_view a, basic_view b) noexcept
+        {
+            return !(a == b);
+        }
+
+    private:
+        CView view_;
+    };
+
+    using view = basic_view<ccstring_view_t>;
+    using slice = basic_view<ccstring_slice_t>;
+
+    /**
+     * @brief Range over the tokens produced by ccstring_split_next, usable in range-based for loops.
+     * The split text and the delimiter must outlive the range.
+    */
+    class split_range {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = slice;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const slice*;
+            using reference = const slice&;
+
+            iterator() noexcept : state_{}, current_{}, at_end_(true) {}
+            explicit iterator(const ccstring_split_t& state) noexcept : state_(state), current_{}, at_end_(false)
+            {
+                advance();
+            }
+
+            reference operator*() const noexcept { return current_; }
+            pointer operator->() const noexcept { return &current_; }
+
+            iterator& operator++() noexcept
+            {
+                advance();
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                iterator previous = *this;
+                advance();
+                return previous;
+            }
+
+            friend bool operator==(const iterator& a, const iterator& b) noexcept
+            {
+                return a.at_end_ && b.at_end_;
+            }
+
+            friend bool operator!=(const iterator& a, const iterator& b) noexcept
+            {
+                return !(a == b);
+            }
+
+        private:
+            void advance() noexcept
+            {
+                ccstring_slice_t token;
+                if (ccstring_split_next(&state_, &token) == 0) {
+                    current_ = slice(token);
+                } else {
+                    at_end_ = true;
+                }
+            }
+
+            ccstring_split_t state_;
+            slice current_;
+            bool at_end_;
+        };
+
+        split_range(view text, std::string_view delimiter) noexcept
+            : state_(ccstring_split_new(text.c_view(), delimiter.data(), delimiter.size()))
+        {
+        }
+
+        iterator begin() const noexcept { return iterator(state_); }
+        iterator end() const noexcept { return iterator(); }
+
+    private:
+        ccstring_split_t state_;
+    };
+
+    /**
+     * @brief Split text on a delimiter without allocating.
+     */
+    inline split_range split(view text, std::string_view delimiter) noexcept
+    {
+        return split_range(text, delimiter);
+    }
+
+    /**
+     * @brief Owning RAII wrapper over ccstring_t.
+     * Moves transfer the underlying pointer without copying; copies duplicate the buffer.
+     * Allocation failures and writes to read-only strings throw. Literals can be wrapped with adopt(&literal)
+     * where literal is declared with CCSTRING_LITERAL_INIT; CCSTRING_LITERAL is C only.
+    */
+    class string {
+    public:
+        string() noexcept = default;
+
+        explicit string(std::string_view text) : str_(ccstring_new(text.data(), text.size()))
+        {
+            if (!str_) {
+                throw std::bad_alloc();
+            }
+        }
+
+        string(const string& other) : string(std::string_view(other)) {}
+
+        string(string&& other) noexcept : str_(std::exchange(other.str_, nullptr)) {}
+
+        ~string() { ccstring_destroy(&str_); }
+
+        string& operator=(const string& other)
+        {
+            if (this != &other) {
+                string copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        string& operator=(string&& other) noexcept
+        {
+            if (this != &other) {
+                ccstring_destroy(&str_);
+                str_ = std::exchange(other.str_, nullptr);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Take ownership of a string created by the C API.
+         */
+        static string adopt(ccstring_t* raw) noexcept
+        {
+            string result;
+            result.str_ = raw;
+            return result;
+        }
+
+        /**
+         * @brief Give up ownership; the caller must release the result with ccstring_destroy.
+         */
+        ccstring_t* release() noexcept { return std::exchange(str_, nullptr); }
+
+        ccstring_t* get() noexcept { return str_; }
+        const ccstring_t* get() const noexcept { return str_; }
+
+        const char* c_str() const noexcept { return str_ ? ccstring_get(str_) : ""; }
+        const char* data() const noexcept { return c_str(); }
+        std::size_t size() const noexcept { return str_ ? ccstring_length(str_) : 0; }
+        bool empty() const noexcept { return size() == 0; }
+
+        const char* begin() const noexcept { return data(); }
+        const char* end() const noexcept { return data() + size(); }
+
+        operator std::string_view() const noexcept { return std::string_view(data(), size()); }
+        view as_view() const noexcept { return view(data(), size()); }
+
+        string& append(std::string_view text)
+        {
+            if (!str_) {
+                *this = string(text);
+            } else if (ccstring_append(&str_, text.data(), text.size()) != 0) {
+                throw_write_error();
+            }
+            return *this;
+        }
+
+        string& operator+=(std::string_view text) { return append(text); }
+
+        string& assign(std::string_view text)
+        {
+            if (!str_) {
+                *this = string(text);
+            } else if (ccstring_copy(&str_, text.data(), text.size()) != 0) {
+                throw_write_error();
+            }
+            return *this;
+        }
+
+        split_range split(std::string_view delimiter) const noexcept
+        {
+            return split_range(as_view(), delimiter);
+        }
+
+        void swap(string& other) noexcept { std::swap(str_, other.str_); }
+
+        friend bool operator==(const string& a, const string& b) noexcept
+        {
+            return std::string_view(a) == std::string_view(b);
+        }
+
+        friend bool operator!=(const string& a, const string& b) noexcept
+        {
+            return !(a == b);
+        }
+
+    private:
+        void throw_write_error() const
+        {
+            if (str_->flags & CCSTRING_FLAG_READONLY) {
+                throw std::logic_error("ccstring: write to a read-only string");
+            }
+            throw std::bad_alloc();
+        }
+
+        ccstring_t* str_ = nullptr;
+    };
+
+} // namespace cc
+
+#endif // __CCSTRING_HPP__
@@ -1,30 +1,329 @@
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "ccstring.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
+
+#if defined(CCSTRING_WINDOWS)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CCSTRING_SSE2
+    #include <emmintrin.h>
+#endif
+
+/**
+ * SSSE3 kernels are compiled with a target attribute and selected at run time, so the default build
+ * still runs on SSE2-only machines.
+*/
+#if defined(CCSTRING_SSE2) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+    #define CCSTRING_SSSE3
+    #include <tmmintrin.h>
+    #if defined(__GNUC__) || defined(__clang__)
+        #define CCSTRING_TARGET_SSSE3 __attribute__((target("ssse3")))
+    #else
+        #define CCSTRING_TARGET_SSSE3
+    #endif
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
 
 #define CCSTRING_NULL_TERMINATER '\0'
 #define CCSTRING_SUCCESS 0
 #define CCSTRING_FAILURE 1
 
+/**
+ * Optional per-thread statistics, compiled in with CCSTRING_STATS.
+*/
+#if defined(CCSTRING_STATS)
+    #if defined(_MSC_VER)
+        #define CCSTRING_THREAD_LOCAL __declspec(thread)
+    #else
+        #define CCSTRING_THREAD_LOCAL _Thread_local
+    #endif
+
+    static CCSTRING_THREAD_LOCAL ccstring_stats_t ccstring_thread_stats;
+
+    #define CCSTRING_STATS_ADD(field, amount) (ccstring_thread_stats.field += (amount))
+    #define CCSTRING_STATS_RECORD_STRING(str) ccstring_stats_record_string(str)
+    #define CCSTRING_STATS_RECORD_MANAGER(mgr) ccstring_stats_record_manager(mgr)
+
+static size_t ccstring_stats_bucket(size_t value)
+{
+    size_t bucket = 0;
+    while (value > 0 && bucket < CCSTRING_STATS_BUCKETS - 1) {
+        value >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+static void ccstring_stats_record_string(const ccstring_t* str)
+{
+    size_t slack = str->capacity > str->length ? str->capacity - str->length - 1 : 0;
+    ccstring_thread_stats.strings_destroyed++;
+    ccstring_thread_stats.length_histogram[ccstring_stats_bucket(str->length)]++;
+    ccstring_thread_stats.slack_histogram[ccstring_stats_bucket(slack)]++;
+}
+
+static void ccstring_stats_record_manager(const ccstring_manager_t* mgr)
+{
+    if (mgr->count > ccstring_thread_stats.manager_peak_count) {
+        ccstring_thread_stats.manager_peak_count = mgr->count;
+    }
+}
+#else
+    #define CCSTRING_STATS_ADD(field, amount) ((void)0)
+    #define CCSTRING_STATS_RECORD_STRING(str) ((void)0)
+    #define CCSTRING_STATS_RECORD_MANAGER(mgr) ((void)0)
+#endif
+
+int ccstring_stats_snapshot(ccstring_stats_t* out)
+{
+    if (!out) {
+        return CCSTRING_FAILURE;
+    }
+
+#if defined(CCSTRING_STATS)
+    *out = ccstring_thread_stats;
+    return CCSTRING_SUCCESS;
+#else
+    memset(out, 0, sizeof(*out));
+    return CCSTRING_FAILURE;
+#endif
+}
+
+void ccstring_stats_reset(void)
+{
+#if defined(CCSTRING_STATS)
+    memset(&ccstring_thread_stats, 0, sizeof(ccstring_thread_stats));
+#endif
+}
+
+static void ccstring_stats_dump_histogram(FILE* stream, const char* name, const size_t* histogram)
+{
+    for (size_t i = 0; i < CCSTRING_STATS_BUCKETS; ++i) {
+        if (histogram[i] == 0) {
+            continue;
+        }
+        if (i == 0) {
+            fprintf(stream, "  %s[0]: %zu\n", name, histogram[i]);
+        } else if (i == CCSTRING_STATS_BUCKETS - 1) {
+            fprintf(stream, "  %s[%zu+]: %zu\n", name, (size_t)1 << (i - 1), histogram[i]);
+        } else {
+            fprintf(stream, "  %s[%zu..%zu]: %zu\n", name, (size_t)1 << (i - 1), ((size_t)1 << i) - 1, histogram[i]);
+        }
+    }
+}
+
+void ccstring_stats_dump(void* output)
+{
+    FILE* stream = (FILE*)output;
+    ccstring_stats_t stats;
+
+    if (!stream) {
+        return;
+    }
+    if (ccstring_stats_snapshot(&stats) != CCSTRING_SUCCESS) {
+        fprintf(stream, "ccstring stats: disabled (build with CCSTRING_ENABLE_STATS)\n");
+        return;
+    }
+
+    fprintf(stream, "ccstring stats:\n");
+    fprintf(stream, "  allocations: %zu\n", stats.allocations);
+    fprintf(stream, "  reallocations: %zu\n", stats.reallocations);
+    fprintf(stream, "  frees: %zu\n", stats.frees);
+    fprintf(stream, "  bytes_allocated: %zu\n", stats.bytes_allocated);
+    fprintf(stream, "  bytes_copied: %zu\n", stats.bytes_copied);
+    fprintf(stream, "  strings_destroyed: %zu\n", stats.strings_destroyed);
+    ccstring_stats_dump_histogram(stream, "length", stats.length_histogram);
+    ccstring_stats_dump_histogram(stream, "slack", stats.slack_histogram);
+    fprintf(stream, "  manager_growths: %zu\n", stats.manager_growths);
+    fprintf(stream, "  manager_peak_count: %zu\n", stats.manager_peak_count);
+}
+
+/**
+ * Allocation wrappers. Every heap allocation made by the library goes through them so the statistics see it.
+*/
+static void* ccstring_malloc(size_t size)
+{
+    CCSTRING_STATS_ADD(allocations, 1);
+    CCSTRING_STATS_ADD(bytes_allocated, size);
+    return malloc(size);
+}
+
+static void* ccstring_calloc(size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    void* ptr = ccstring_malloc(count * size);
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+static void* ccstring_realloc(void* ptr, size_t size)
+{
+    CCSTRING_STATS_ADD(reallocations, 1);
+    CCSTRING_STATS_ADD(bytes_allocated, size);
+    return realloc(ptr, size);
+}
+
+static void ccstring_free(void* ptr)
+{
+    if (ptr) {
+        CCSTRING_STATS_ADD(frees, 1);
+        free(ptr);
+    }
+}
+
+// Index of the lowest set bit. value must be non-zero.
+static unsigned int ccstring_ctz32(uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned int)__builtin_ctz(value);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (unsigned int)index;
+#else
+    unsigned int index = 0;
+    while ((value & 1u) == 0) {
+        value >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+// Index of the lowest set bit. value must be non-zero.
+static unsigned int ccstring_ctz64(uint64_t value)
+{
+    uint32_t low = (uint32_t)value;
+    return low != 0 ? ccstring_ctz32(low) : 32 + ccstring_ctz32((uint32_t)(value >> 32));
+}
+
+/**
+ * Minimal thread shim used by the parallel algorithms.
+*/
+#if defined(CCSTRING_WINDOWS)
+    typedef HANDLE ccstring_thread_t;
+    #define CCSTRING_THREAD_RETURN DWORD WINAPI
+    #define CCSTRING_THREAD_RESULT 0
+#else
+    typedef pthread_t ccstring_thread_t;
+    #define CCSTRING_THREAD_RETURN void*
+    #define CCSTRING_THREAD_RESULT NULL
+#endif
+
+#define CCSTRING_MAX_THREADS 64
+
+typedef CCSTRING_THREAD_RETURN ccstring_thread_fn(void* arg);
+
+static int ccstring_thread_start(ccstring_thread_t* thread, ccstring_thread_fn* fn, void* arg)
+{
+#if defined(CCSTRING_WINDOWS)
+    *thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    return *thread != NULL ? CCSTRING_SUCCESS : CCSTRING_FAILURE;
+#else
+    return pthread_create(thread, NULL, fn, arg) == 0 ? CCSTRING_SUCCESS : CCSTRING_FAILURE;
+#endif
+}
+
+static void ccstring_thread_join(ccstring_thread_t thread)
+{
+#if defined(CCSTRING_WINDOWS)
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+static size_t ccstring_thread_count(void)
+{
+    long count;
+#if defined(CCSTRING_WINDOWS)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    count = (long)info.dwNumberOfProcessors;
+#else
+    count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (count < 1) {
+        return 1;
+    }
+    return count > CCSTRING_MAX_THREADS ? CCSTRING_MAX_THREADS : (size_t)count;
+}
+
+// Makes room for length bytes plus the null terminator. Borrowed buffers spill to the heap on growth.
+static int ccstring_reserve_internal(ccstring_t* str, size_t length)
+{
+    if (str->flags & CCSTRING_FLAG_READONLY) {
+        return CCSTRING_FAILURE;
+    }
+    if (length < str->capacity) {
+        return CCSTRING_SUCCESS;
+    }
+
+    if (str->flags & CCSTRING_FLAG_BORROWED) {
+        char* heap_buffer = (char*)ccstring_malloc(length + 1);
+        if (!heap_buffer) {
+            return CCSTRING_FAILURE;
+        }
+        if (str->length > 0) {
+            memcpy(heap_buffer, str->buffer, str->length);
+        }
+        str->buffer = heap_buffer;
+        str->flags &= ~(unsigned int)CCSTRING_FLAG_BORROWED;
+    } else {
+        char* new_buffer = (char*)ccstring_realloc(str->buffer, length + 1);
+        if (!new_buffer) {
+            return CCSTRING_FAILURE;
+        }
+        str->buffer = new_buffer;
+    }
+
+    str->capacity = length + 1;
+    return CCSTRING_SUCCESS;
+}
+
 ccstring_t* ccstring_new(const char* str, size_t size)
 {
-    ccstring_t* new_str = (ccstring_t*)malloc(sizeof(*new_str));
+    ccstring_t* new_str = (ccstring_t*)ccstring_malloc(sizeof(*new_str));
     if (!new_str) {
         return NULL;
     }
 
     new_str->length = size;
     new_str->capacity = size + 1;
-    new_str->buffer = (char*)malloc(new_str->capacity);
+    new_str->flags = 0;
+    new_str->buffer = (char*)ccstring_malloc(new_str->capacity);
     if (!new_str->buffer) {
-        free(new_str);
+        ccstring_free(new_str);
         return NULL;
     }
 
     if (str != NULL && size > 0) {
         memcpy(new_str->buffer, str, size);
+        CCSTRING_STATS_ADD(bytes_copied, size);
     }
     new_str->buffer[size] = CCSTRING_NULL_TERMINATER;
 
@@ -37,26 +336,28 @@ ccstring_t* ccstring_auto(const char* str)
         return NULL;
     }
 
-    ccstring_t* new_str = (ccstring_t*)malloc(sizeof(*new_str));
+    ccstring_t* new_str = (ccstring_t*)ccstring_malloc(sizeof(*new_str));
     if (!new_str) {
         return NULL;
     }
 
     size_t str_size = strlen(str);
     if (str_size == 0) {
-        free(new_str);
+        ccstring_free(new_str);
         return NULL;
     }
 
     new_str->length = str_size;
     new_str->capacity = str_size + 1;
-    new_str->buffer = (char*)malloc(new_str->capacity);
+    new_str->flags = 0;
+    new_str->buffer = (char*)ccstring_malloc(new_str->capacity);
     if (new_str->buffer == NULL) {
-        free(new_str);
+        ccstring_free(new_str);
         return NULL;
     }
 
     memcpy(new_str->buffer, str, str_size);
+    CCSTRING_STATS_ADD(bytes_copied, str_size);
     new_str->buffer[new_str->length] = CCSTRING_NULL_TERMINATER;
     return new_str;
 }
@@ -89,16 +390,17 @@ ccstring_t* ccstring_new_from_slice(const ccstring_slice_t* slice)
 
 ccstring_t* ccstring_new_empty(size_t size)
 {
-    ccstring_t* new_str = (ccstring_t*)malloc(sizeof(*new_str));
+    ccstring_t* new_str = (ccstring_t*)ccstring_malloc(sizeof(*new_str));
     if (!new_str) {
         return NULL;
     }
 
     new_str->length = 0;
     new_str->capacity = size + 1;
-    new_str->buffer = (char*)malloc(new_str->capacity);
+    new_str->flags = 0;
+    new_str->buffer = (char*)ccstring_malloc(new_str->capacity);
     if (!new_str->buffer) {
-        free(new_str);
+        ccstring_free(new_str);
         return NULL;
     }
 
@@ -117,15 +419,23 @@ size_t ccstring_length(const ccstring_t* str)
     return str->length;
 }
 
+ccstring_view_t ccstring_view_of(const ccstring_t* str)
+{
+    ccstring_view_t view;
+    view.buffer = str->buffer;
+    view.length = str->length;
+    return view;
+}
+
 ccstring_view_t* ccstring_view_new(const ccstring_t* str)
 {
-    ccstring_view_t* view = (ccstring_view_t*)malloc(sizeof(*view));
+    ccstring_view_t* view = (ccstring_view_t*)ccstring_malloc(sizeof(*view));
     if (!view) {
         return NULL;
     }
 
     if (!str || !str->buffer) {
-        free(view);
+        ccstring_free(view);
         return NULL;
     }
 
@@ -144,7 +454,7 @@ ccstring_slice_t* ccstring_slice_new(ccstring_t* str, size_t start, size_t end)
         return NULL; // Invalid range
     }
 
-    ccstring_slice_t* slice = (ccstring_slice_t*)malloc(sizeof(ccstring_slice_t));
+    ccstring_slice_t* slice = (ccstring_slice_t*)ccstring_malloc(sizeof(ccstring_slice_t));
     if (!slice) {
         return NULL; // Memory allocation failed
     }
@@ -155,6 +465,60 @@ ccstring_slice_t* ccstring_slice_new(ccstring_t* str, size_t start, size_t end)
     return slice;
 }
 
+ccstring_split_t ccstring_split_new(const ccstring_view_t* view, const char* delimiter, size_t delimiter_length)
+{
+    ccstring_split_t split = {0};
+
+    if (!view || (!view->buffer && view->length > 0) || (!delimiter && delimiter_length > 0)) {
+        split.done = 1;
+        return split;
+    }
+
+    split.cursor = view->buffer;
+    split.end = view->buffer ? view->buffer + view->length : NULL;
+    split.delimiter = delimiter;
+    split.delimiter_length = delimiter_length;
+    return split;
+}
+
+int ccstring_split_next(ccstring_split_t* split, ccstring_slice_t* out_slice)
+{
+    if (!split || !out_slice || split->done) {
+        return CCSTRING_FAILURE;
+    }
+
+    const char* start = split->cursor;
+    size_t remaining = (size_t)(split->end - start);
+    const char* found = NULL;
+
+    if (split->delimiter_length > 0) {
+        const char* scan = start;
+        while (remaining - (size_t)(scan - start) >= split->delimiter_length) {
+            scan = (const char*)memchr(scan, split->delimiter[0], remaining - (size_t)(scan - start) - split->delimiter_length + 1);
+            if (!scan) {
+                break;
+            }
+            if (memcmp(scan, split->delimiter, split->delimiter_length) == 0) {
+                found = scan;
+                break;
+            }
+            ++scan;
+        }
+    }
+
+    out_slice->buffer = start;
+    if (found) {
+        out_slice->length = (size_t)(found - start);
+        split->cursor = found + split->delimiter_length;
+    } else {
+        out_slice->length = remaining;
+        split->cursor = split->end;
+        split->done = 1;
+    }
+
+    return CCSTRING_SUCCESS;
+}
+
 int ccstring_resize(ccstring_t** str, size_t new_size)
 {
     if (!str || !*str) {
@@ -162,13 +526,8 @@ int ccstring_resize(ccstring_t** str, size_t new_size)
     }
 
     ccstring_t* old_str = *str;
-    if (new_size > old_str->capacity) {
-        char* new_buffer = (char*)realloc(old_str->buffer, new_size + 1);
-        if (!new_buffer) {
-            return CCSTRING_FAILURE;
-        }
-        old_str->buffer = new_buffer;
-        old_str->capacity = new_size + 1;
+    if (ccstring_reserve_internal(old_str, new_size) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
     }
 
     old_str->length = new_size;
@@ -184,16 +543,12 @@ int ccstring_copy(ccstring_t** str, const char* new_str, size_t new_size)
     }
 
     ccstring_t* old_str = *str;
-    if (new_size > old_str->capacity) {
-        char* new_buffer = (char*)realloc(old_str->buffer, new_size + 1);
-        if (!new_buffer) {
-            return CCSTRING_FAILURE; 
-        }
-        old_str->buffer = new_buffer;
-        old_str->capacity = new_size + 1;
+    if (ccstring_reserve_internal(old_str, new_size) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
     }
 
     memcpy(old_str->buffer, new_str, new_size);
+    CCSTRING_STATS_ADD(bytes_copied, new_size);
     old_str->length = new_size;
     old_str->buffer[new_size] = CCSTRING_NULL_TERMINATER;
 
@@ -207,16 +562,12 @@ int ccstring_copy_slice(ccstring_t** str, const ccstring_slice_t* slice)
     }
 
     ccstring_t* old_str = *str;
-    if (slice->length > old_str->capacity) {
-        char* new_buffer = (char*)realloc(old_str->buffer, slice->length + 1);
-        if (!new_buffer) {
-            return CCSTRING_FAILURE; 
-        }
-        old_str->buffer = new_buffer;
-        old_str->capacity = slice->length + 1; 
+    if (ccstring_reserve_internal(old_str, slice->length) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
     }
 
     memcpy(old_str->buffer, slice->buffer, slice->length);
+    CCSTRING_STATS_ADD(bytes_copied, slice->length);
     old_str->length = slice->length;
     old_str->buffer[slice->length] = CCSTRING_NULL_TERMINATER;
 
@@ -230,16 +581,12 @@ int ccstring_copy_view(ccstring_t** str, const ccstring_view_t* view)
     }
 
     ccstring_t* old_str = *str;
-    if (view->length > old_str->capacity) {
-        char* new_buffer = (char*)realloc(old_str->buffer, view->length + 1);
-        if (!new_buffer) {
-            return CCSTRING_FAILURE;
-        }
-        old_str->buffer = new_buffer;
-        old_str->capacity = view->length + 1;
+    if (ccstring_reserve_internal(old_str, view->length) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
     }
 
     memcpy(old_str->buffer, view->buffer, view->length);
+    CCSTRING_STATS_ADD(bytes_copied, view->length);
     old_str->length = view->length;
     old_str->buffer[view->length] = CCSTRING_NULL_TERMINATER;
 
@@ -278,16 +625,12 @@ int ccstring_append(ccstring_t** str, const char* new_str, size_t new_size)
     ccstring_t* old_str = *str;
     size_t new_length = old_str->length + new_size;
 
-    if (new_length > old_str->capacity) {
-        char* new_buffer = (char*)realloc(old_str->buffer, new_length + 1);
-        if (!new_buffer) {
-            return CCSTRING_FAILURE;
-        }
-        old_str->buffer = new_buffer;
-        old_str->capacity = new_length + 1;
+    if (ccstring_reserve_internal(old_str, new_length) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
     }
 
     memcpy(old_str->buffer + old_str->length, new_str, new_size);
+    CCSTRING_STATS_ADD(bytes_copied, new_size);
     old_str->length = new_length;
     old_str->buffer[new_length] = CCSTRING_NULL_TERMINATER;
 
@@ -297,16 +640,35 @@ int ccstring_append(ccstring_t** str, const char* new_str, size_t new_size)
 void ccstring_destroy(ccstring_t** str)
 {
     if (str && *str) {
-        free((*str)->buffer);
-        free(*str);
+        CCSTRING_STATS_RECORD_STRING(*str);
+        if (!((*str)->flags & CCSTRING_FLAG_BORROWED)) {
+            ccstring_free((*str)->buffer);
+        }
+        if (!((*str)->flags & CCSTRING_FLAG_STATIC)) {
+            ccstring_free(*str);
+        }
         *str = NULL; // Set the pointer to NULL
     }
 }
 
+ccstring_t ccstring_stack(char* buffer, size_t buffer_size)
+{
+    ccstring_t str = {0};
+    str.flags = CCSTRING_FLAG_STATIC | CCSTRING_FLAG_BORROWED;
+
+    // Without a usable buffer the string starts with no capacity and spills on the first write.
+    if (buffer && buffer_size > 0) {
+        str.buffer = buffer;
+        str.capacity = buffer_size;
+        buffer[0] = CCSTRING_NULL_TERMINATER;
+    }
+    return str;
+}
+
 void ccstring_slice_destroy(ccstring_slice_t** slice)
 {
     if (slice && *slice) {
-        free(*slice);
+        ccstring_free(*slice);
         *slice = NULL; // Set the pointer to NULL
     }
 }
@@ -314,7 +676,7 @@ void ccstring_slice_destroy(ccstring_slice_t** slice)
 void ccstring_view_destroy(ccstring_view_t** view)
 {
     if (view && *view) {
-        free(*view);
+        ccstring_free(*view);
         *view = NULL;
     }
 }
@@ -326,7 +688,7 @@ ccstring_manager_t ccstring_manager_new(size_t initial_capacity)
         initial_capacity = 1;
     }
 
-    mgr.list = (ccstring_t**)malloc(initial_capacity * sizeof(*mgr.list));
+    mgr.list = (ccstring_t**)ccstring_malloc(initial_capacity * sizeof(*mgr.list));
     if (mgr.list != NULL) {
         mgr.capacity = initial_capacity;
     }
@@ -350,15 +712,17 @@ int ccstring_manager_add(ccstring_manager_t* mgr, ccstring_t* str, size_t max_ca
 
     if (mgr->count >= mgr->capacity) {
         size_t new_capacity = mgr->capacity + (max_capacity > 0 ? max_capacity : mgr->capacity);
-        ccstring_t** temp = (ccstring_t**)realloc(mgr->list, new_capacity * sizeof(*temp));
+        ccstring_t** temp = (ccstring_t**)ccstring_realloc(mgr->list, new_capacity * sizeof(*temp));
         if (!temp) {
             return CCSTRING_FAILURE;
         }
         mgr->list = temp;
         mgr->capacity = new_capacity;
+        CCSTRING_STATS_ADD(manager_growths, 1);
     }
 
     mgr->list[mgr->count++] = str;
+    CCSTRING_STATS_RECORD_MANAGER(mgr);
     return CCSTRING_SUCCESS;
 }
 
@@ -390,8 +754,3483 @@ void ccstring_manager_destroy(ccstring_manager_t* mgr)
         }
     }
 
-    free(mgr->list);
+    ccstring_free(mgr->list);
     mgr->list = NULL;
     mgr->count = 0;
     mgr->capacity = 0;
-}
\ No newline at end of file
+}
+/**
+ * Sorting: multikey quicksort over 8-byte chunks cached next to each key, so most
+ * comparisons touch only the contiguous key array instead of the string buffers.
+*/
+#define CCSTRING_SORT_INSERTION_THRESHOLD 16
+#define CCSTRING_SORT_PARALLEL_THRESHOLD 65536
+#define CCSTRING_SORT_BUCKETS 256
+
+typedef struct ccstring_sort_key {
+    uint64_t cache;
+    const unsigned char* buffer;
+    size_t length;
+    size_t index;
+} ccstring_sort_key_t;
+
+static uint64_t ccstring_sort_load(const unsigned char* buffer, size_t length, size_t depth)
+{
+    uint64_t value = 0;
+    size_t remaining = length > depth ? length - depth : 0;
+    size_t i;
+
+    if (remaining == 0) {
+        return 0;
+    }
+    if (remaining > 8) {
+        remaining = 8;
+    }
+    for (i = 0; i < remaining; ++i) {
+        value = (value << 8) | buffer[depth + i];
+    }
+    return remaining == 8 ? value : value << (8 * (8 - remaining));
+}
+
+static void ccstring_sort_refresh(ccstring_sort_key_t* keys, size_t count, size_t depth)
+{
+    for (size_t i = 0; i < count; ++i) {
+        keys[i].cache = ccstring_sort_load(keys[i].buffer, keys[i].length, depth);
+    }
+}
+
+static size_t ccstring_sort_chunk_length(const ccstring_sort_key_t* key, size_t depth)
+{
+    size_t remaining = key->length - depth;
+    return remaining < 8 ? remaining : 8;
+}
+
+// Compares the cached chunks only. Zero padding plus the chunk length tie-break keeps byte order.
+static int ccstring_sort_chunk_compare(const ccstring_sort_key_t* a, const ccstring_sort_key_t* b, size_t depth)
+{
+    if (a->cache != b->cache) {
+        return a->cache < b->cache ? -1 : 1;
+    }
+
+    size_t la = ccstring_sort_chunk_length(a, depth);
+    size_t lb = ccstring_sort_chunk_length(b, depth);
+    return (la > lb) - (la < lb);
+}
+
+static int ccstring_sort_full_compare(const ccstring_sort_key_t* a, const ccstring_sort_key_t* b, size_t depth, int stable)
+{
+    int cmp = ccstring_sort_chunk_compare(a, b, depth);
+    if (cmp == 0 && ccstring_sort_chunk_length(a, depth) == 8) {
+        size_t offset = depth + 8;
+        size_t common = (a->length < b->length ? a->length : b->length) - offset;
+        cmp = memcmp(a->buffer + offset, b->buffer + offset, common);
+        if (cmp == 0) {
+            cmp = (a->length > b->length) - (a->length < b->length);
+        }
+    }
+
+    if (cmp == 0 && stable) {
+        cmp = (a->index > b->index) - (a->index < b->index);
+    }
+    return cmp;
+}
+
+static void ccstring_sort_swap(ccstring_sort_key_t* a, ccstring_sort_key_t* b)
+{
+    ccstring_sort_key_t temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+static void ccstring_sort_insertion(ccstring_sort_key_t* keys, size_t count, size_t depth, int stable)
+{
+    for (size_t i = 1; i < count; ++i) {
+        ccstring_sort_key_t key = keys[i];
+        size_t j = i;
+        while (j > 0 && ccstring_sort_full_compare(&keys[j - 1], &key, depth, stable) > 0) {
+            keys[j] = keys[j - 1];
+            --j;
+        }
+        keys[j] = key;
+    }
+}
+
+static int ccstring_sort_index_compare(const void* a, const void* b)
+{
+    size_t ia = ((const ccstring_sort_key_t*)a)->index;
+    size_t ib = ((const ccstring_sort_key_t*)b)->index;
+    return (ia > ib) - (ia < ib);
+}
+
+static size_t ccstring_sort_median(ccstring_sort_key_t* keys, size_t count, size_t depth)
+{
+    size_t a = 0;
+    size_t b = count / 2;
+    size_t c = count - 1;
+
+    if (ccstring_sort_chunk_compare(&keys[a], &keys[b], depth) < 0) {
+        if (ccstring_sort_chunk_compare(&keys[b], &keys[c], depth) < 0) {
+            return b;
+        }
+        return ccstring_sort_chunk_compare(&keys[a], &keys[c], depth) < 0 ? c : a;
+    }
+    if (ccstring_sort_chunk_compare(&keys[a], &keys[c], depth) < 0) {
+        return a;
+    }
+    return ccstring_sort_chunk_compare(&keys[b], &keys[c], depth) < 0 ? c : b;
+}
+
+static void ccstring_sort_mkqs(ccstring_sort_key_t* keys, size_t count, size_t depth, int stable)
+{
+    while (count > 1) {
+        if (count < CCSTRING_SORT_INSERTION_THRESHOLD) {
+            ccstring_sort_insertion(keys, count, depth, stable);
+            return;
+        }
+
+        ccstring_sort_swap(&keys[0], &keys[ccstring_sort_median(keys, count, depth)]);
+        ccstring_sort_key_t pivot = keys[0];
+
+        // Three-way partition: [0, lt) < pivot, [lt, gt) == pivot, [gt, count) > pivot.
+        size_t lt = 0;
+        size_t gt = count;
+        size_t i = 1;
+        while (i < gt) {
+            int cmp = ccstring_sort_chunk_compare(&keys[i], &pivot, depth);
+            if (cmp < 0) {
+                ccstring_sort_swap(&keys[lt++], &keys[i++]);
+            } else if (cmp > 0) {
+                ccstring_sort_swap(&keys[i], &keys[--gt]);
+            } else {
+                ++i;
+            }
+        }
+
+        ccstring_sort_key_t* middle = keys + lt;
+        size_t middle_count = gt - lt;
+        size_t greater_count = count - gt;
+        if (ccstring_sort_chunk_length(&pivot, depth) < 8) {
+            // Every key in the middle partition ends inside this chunk, so they are identical.
+            if (stable && middle_count > 1) {
+                qsort(middle, middle_count, sizeof(*middle), ccstring_sort_index_compare);
+            }
+            middle_count = 0;
+        } else {
+            ccstring_sort_refresh(middle, middle_count, depth + 8);
+        }
+
+        // Recurse into the two smaller partitions and loop on the largest, so the stack stays O(log n) deep.
+        if (middle_count >= lt && middle_count >= greater_count) {
+            ccstring_sort_mkqs(keys, lt, depth, stable);
+            ccstring_sort_mkqs(keys + gt, greater_count, depth, stable);
+            keys = middle;
+            count = middle_count;
+            depth += 8;
+        } else if (lt >= greater_count) {
+            ccstring_sort_mkqs(middle, middle_count, depth + 8, stable);
+            ccstring_sort_mkqs(keys + gt, greater_count, depth, stable);
+            count = lt;
+        } else {
+            ccstring_sort_mkqs(keys, lt, depth, stable);
+            ccstring_sort_mkqs(middle, middle_count, depth + 8, stable);
+            keys += gt;
+            count = greater_count;
+        }
+    }
+}
+
+typedef struct ccstring_sort_task {
+    ccstring_sort_key_t* keys;
+    const size_t* starts;
+    const size_t* counts;
+    size_t buckets[CCSTRING_SORT_BUCKETS];
+    size_t bucket_count;
+    size_t load;
+    size_t depth;
+    int stable;
+} ccstring_sort_task_t;
+
+static CCSTRING_THREAD_RETURN ccstring_sort_worker(void* arg)
+{
+    ccstring_sort_task_t* task = (ccstring_sort_task_t*)arg;
+
+    for (size_t i = 0; i < task->bucket_count; ++i) {
+        size_t bucket = task->buckets[i];
+        ccstring_sort_mkqs(task->keys + task->starts[bucket], task->counts[bucket], task->depth, task->stable);
+    }
+    return CCSTRING_THREAD_RESULT;
+}
+
+// Distributes the keys by their first differing byte, then sorts the buckets on separate threads.
+static int ccstring_sort_parallel(ccstring_sort_key_t* keys, size_t count, int stable)
+{
+    size_t counts[CCSTRING_SORT_BUCKETS] = {0};
+    size_t starts[CCSTRING_SORT_BUCKETS];
+    size_t order[CCSTRING_SORT_BUCKETS];
+    size_t thread_count = ccstring_thread_count();
+
+    if (thread_count < 2) {
+        ccstring_sort_mkqs(keys, count, 0, stable);
+        return CCSTRING_SUCCESS;
+    }
+
+    // Skip the prefix every key shares, then bucket on the first cached byte that differs,
+    // so lists such as URLs that all start with the same scheme still split.
+    size_t depth = 0;
+    uint64_t diff = 0;
+    for (;;) {
+        int whole = 1;
+        for (size_t i = 1; i < count; ++i) {
+            diff |= keys[i].cache ^ keys[0].cache;
+        }
+        for (size_t i = 0; i < count && whole; ++i) {
+            whole = keys[i].length - depth >= 8;
+        }
+        if (diff != 0 || !whole) {
+            break;
+        }
+        depth += 8;
+        ccstring_sort_refresh(keys, count, depth);
+    }
+    if (diff == 0) {
+        // A key ends inside the shared chunk, so what is left to order is mostly lengths.
+        ccstring_sort_mkqs(keys, count, depth, stable);
+        return CCSTRING_SUCCESS;
+    }
+
+    ccstring_sort_key_t* aux = (ccstring_sort_key_t*)ccstring_malloc(count * sizeof(*aux));
+    ccstring_sort_task_t* tasks = (ccstring_sort_task_t*)ccstring_calloc(thread_count, sizeof(*tasks));
+    ccstring_thread_t* threads = (ccstring_thread_t*)ccstring_malloc(thread_count * sizeof(*threads));
+    int* started = (int*)ccstring_calloc(thread_count, sizeof(*started));
+    if (!aux || !tasks || !threads || !started) {
+        ccstring_free(aux);
+        ccstring_free(tasks);
+        ccstring_free(threads);
+        ccstring_free(started);
+        return CCSTRING_FAILURE;
+    }
+
+    unsigned int shift = 56;
+    while ((diff >> shift) == 0) {
+        shift -= 8;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        counts[(keys[i].cache >> shift) & 0xFF]++;
+    }
+
+    size_t offset = 0;
+    for (size_t b = 0; b < CCSTRING_SORT_BUCKETS; ++b) {
+        starts[b] = offset;
+        offset += counts[b];
+    }
+
+    // Stable distribution keeps the original order inside each bucket.
+    size_t cursor[CCSTRING_SORT_BUCKETS];
+    memcpy(cursor, starts, sizeof(cursor));
+    for (size_t i = 0; i < count; ++i) {
+        aux[cursor[(keys[i].cache >> shift) & 0xFF]++] = keys[i];
+    }
+    memcpy(keys, aux, count * sizeof(*keys));
+    ccstring_free(aux);
+
+    // Largest bucket first, each one handed to the least loaded thread.
+    for (size_t b = 0; b < CCSTRING_SORT_BUCKETS; ++b) {
+        size_t j = b;
+        while (j > 0 && counts[order[j - 1]] < counts[b]) {
+            order[j] = order[j - 1];
+            --j;
+        }
+        order[j] = b;
+    }
+
+    for (size_t t = 0; t < thread_count; ++t) {
+        tasks[t].keys = keys;
+        tasks[t].starts = starts;
+        tasks[t].counts = counts;
+        tasks[t].depth = depth;
+        tasks[t].stable = stable;
+    }
+
+    for (size_t i = 0; i < CCSTRING_SORT_BUCKETS && counts[order[i]] > 1; ++i) {
+        size_t target = 0;
+        for (size_t t = 1; t < thread_count; ++t) {
+            if (tasks[t].load < tasks[target].load) {
+                target = t;
+            }
+        }
+        tasks[target].buckets[tasks[target].bucket_count++] = order[i];
+        tasks[target].load += counts[order[i]];
+    }
+
+    for (size_t t = 1; t < thread_count; ++t) {
+        if (tasks[t].bucket_count > 0) {
+            started[t] = ccstring_thread_start(&threads[t], ccstring_sort_worker, &tasks[t]) == CCSTRING_SUCCESS;
+        }
+    }
+
+    ccstring_sort_worker(&tasks[0]);
+
+    for (size_t t = 1; t < thread_count; ++t) {
+        if (started[t]) {
+            ccstring_thread_join(threads[t]);
+        } else if (tasks[t].bucket_count > 0) {
+            ccstring_sort_worker(&tasks[t]);
+        }
+    }
+
+    ccstring_free(tasks);
+    ccstring_free(threads);
+    ccstring_free(started);
+    return CCSTRING_SUCCESS;
+}
+
+static int ccstring_sort_keys(ccstring_sort_key_t* keys, size_t count, int flags)
+{
+    int stable = (flags & CCSTRING_SORT_STABLE) != 0;
+
+    ccstring_sort_refresh(keys, count, 0);
+    if ((flags & CCSTRING_SORT_PARALLEL) && count >= CCSTRING_SORT_PARALLEL_THRESHOLD) {
+        return ccstring_sort_parallel(keys, count, stable);
+    }
+
+    ccstring_sort_mkqs(keys, count, 0, stable);
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_sort(ccstring_t** list, size_t count, int flags)
+{
+    if (count < 2) {
+        return list || count == 0 ? CCSTRING_SUCCESS : CCSTRING_FAILURE;
+    }
+    if (!list) {
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_sort_key_t* keys = (ccstring_sort_key_t*)ccstring_malloc(count * sizeof(*keys));
+    ccstring_t** original = (ccstring_t**)ccstring_malloc(count * sizeof(*original));
+    if (!keys || !original) {
+        ccstring_free(keys);
+        ccstring_free(original);
+        return CCSTRING_FAILURE;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!list[i] || !list[i]->buffer) {
+            ccstring_free(keys);
+            ccstring_free(original);
+            return CCSTRING_FAILURE;
+        }
+        keys[i].buffer = (const unsigned char*)list[i]->buffer;
+        keys[i].length = list[i]->length;
+        keys[i].index = i;
+    }
+    memcpy(original, list, count * sizeof(*original));
+
+    if (ccstring_sort_keys(keys, count, flags) != CCSTRING_SUCCESS) {
+        ccstring_free(keys);
+        ccstring_free(original);
+        return CCSTRING_FAILURE;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        list[i] = original[keys[i].index];
+    }
+
+    ccstring_free(keys);
+    ccstring_free(original);
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_view_sort(ccstring_view_t* views, size_t count, int flags)
+{
+    if (count < 2) {
+        return views || count == 0 ? CCSTRING_SUCCESS : CCSTRING_FAILURE;
+    }
+    if (!views) {
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_sort_key_t* keys = (ccstring_sort_key_t*)ccstring_malloc(count * sizeof(*keys));
+    if (!keys) {
+        return CCSTRING_FAILURE;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        keys[i].buffer = (const unsigned char*)views[i].buffer;
+        keys[i].length = views[i].length;
+        keys[i].index = i;
+    }
+
+    if (ccstring_sort_keys(keys, count, flags) != CCSTRING_SUCCESS) {
+        ccstring_free(keys);
+        return CCSTRING_FAILURE;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        views[i].buffer = (const char*)keys[i].buffer;
+        views[i].length = keys[i].length;
+    }
+
+    ccstring_free(keys);
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_manager_sort(ccstring_manager_t* mgr, int flags)
+{
+    if (!mgr) {
+        return CCSTRING_FAILURE;
+    }
+
+    return ccstring_sort(mgr->list, mgr->count, flags);
+}
+
+/**
+ * Packed string table: one data buffer plus an offset array with count + 1 entries.
+*/
+#define CCSTRING_TABLE_MIN_COUNT 16
+#define CCSTRING_TABLE_MIN_BYTES 256
+
+static size_t ccstring_table_offset(const ccstring_table_t* table, size_t index)
+{
+    if (table->offset_width == sizeof(uint32_t)) {
+        return ((const uint32_t*)table->offsets)[index];
+    }
+    return (size_t)((const uint64_t*)table->offsets)[index];
+}
+
+static void ccstring_table_set_offset(ccstring_table_t* table, size_t index, size_t offset)
+{
+    if (table->offset_width == sizeof(uint32_t)) {
+        ((uint32_t*)table->offsets)[index] = (uint32_t)offset;
+    } else {
+        ((uint64_t*)table->offsets)[index] = (uint64_t)offset;
+    }
+}
+
+// Switches the offset array to 64-bit entries once the data no longer fits in 32 bits.
+static int ccstring_table_widen(ccstring_table_t* table)
+{
+    uint64_t* wide = (uint64_t*)ccstring_malloc((table->capacity + 1) * sizeof(*wide));
+    if (!wide) {
+        return CCSTRING_FAILURE;
+    }
+
+    for (size_t i = 0; i <= table->count; ++i) {
+        wide[i] = ((const uint32_t*)table->offsets)[i];
+    }
+
+    ccstring_free(table->offsets);
+    table->offsets = wide;
+    table->offset_width = sizeof(uint64_t);
+    return CCSTRING_SUCCESS;
+}
+
+static int ccstring_table_reserve(ccstring_table_t* table, size_t extra_count, size_t extra_bytes)
+{
+    if (table->offset_width == 0) {
+        table->offset_width = sizeof(uint32_t);
+    }
+
+    if (table->count + extra_count > table->capacity || !table->offsets) {
+        size_t new_capacity = table->capacity > 0 ? table->capacity : CCSTRING_TABLE_MIN_COUNT;
+        while (new_capacity < table->count + extra_count) {
+            new_capacity *= 2;
+        }
+
+        void* offsets = ccstring_realloc(table->offsets, (new_capacity + 1) * table->offset_width);
+        if (!offsets) {
+            return CCSTRING_FAILURE;
+        }
+        if (!table->offsets) {
+            memset(offsets, 0, table->offset_width);
+        }
+        table->offsets = offsets;
+        table->capacity = new_capacity;
+    }
+
+    if (table->data_length + extra_bytes > table->data_capacity || !table->data) {
+        size_t new_capacity = table->data_capacity > 0 ? table->data_capacity : CCSTRING_TABLE_MIN_BYTES;
+        while (new_capacity < table->data_length + extra_bytes) {
+            new_capacity *= 2;
+        }
+
+        char* data = (char*)ccstring_realloc(table->data, new_capacity);
+        if (!data) {
+            return CCSTRING_FAILURE;
+        }
+        table->data = data;
+        table->data_capacity = new_capacity;
+    }
+
+    return CCSTRING_SUCCESS;
+}
+
+ccstring_table_t ccstring_table_new(size_t initial_count, size_t initial_bytes)
+{
+    ccstring_table_t table = {0};
+    table.offset_width = sizeof(uint32_t);
+
+    if (initial_count == 0) {
+        initial_count = CCSTRING_TABLE_MIN_COUNT;
+    }
+    if (initial_bytes == 0) {
+        initial_bytes = CCSTRING_TABLE_MIN_BYTES;
+    }
+
+    table.offsets = ccstring_malloc((initial_count + 1) * table.offset_width);
+    table.data = (char*)ccstring_malloc(initial_bytes + initial_count);
+    if (!table.offsets || !table.data) {
+        ccstring_free(table.offsets);
+        ccstring_free(table.data);
+        table.offsets = NULL;
+        table.data = NULL;
+        return table;
+    }
+
+    ((uint32_t*)table.offsets)[0] = 0;
+    table.capacity = initial_count;
+    table.data_capacity = initial_bytes + initial_count;
+    return table;
+}
+
+int ccstring_table_append(ccstring_table_t* table, const char* str, size_t size)
+{
+    if (!table || table->frozen || (!str && size > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    if (ccstring_table_reserve(table, 1, size + 1) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    size_t end = table->data_length + size + 1;
+    if (table->offset_width == sizeof(uint32_t) && end > UINT32_MAX) {
+        if (ccstring_table_widen(table) != CCSTRING_SUCCESS) {
+            return CCSTRING_FAILURE;
+        }
+    }
+
+    if (size > 0) {
+        memcpy(table->data + table->data_length, str, size);
+        CCSTRING_STATS_ADD(bytes_copied, size);
+    }
+    table->data[end - 1] = CCSTRING_NULL_TERMINATER;
+    table->data_length = end;
+    ccstring_table_set_offset(table, ++table->count, end);
+
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_table_append_manager(ccstring_table_t* table, const ccstring_manager_t* mgr)
+{
+    size_t bytes = 0;
+
+    if (!table || !mgr || table->frozen) {
+        return CCSTRING_FAILURE;
+    }
+
+    for (size_t i = 0; i < mgr->count; ++i) {
+        if (!mgr->list[i]) {
+            return CCSTRING_FAILURE;
+        }
+        bytes += mgr->list[i]->length + 1;
+    }
+
+    if (ccstring_table_reserve(table, mgr->count, bytes) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    for (size_t i = 0; i < mgr->count; ++i) {
+        if (ccstring_table_append(table, mgr->list[i]->buffer, mgr->list[i]->length) != CCSTRING_SUCCESS) {
+            return CCSTRING_FAILURE;
+        }
+    }
+
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_table_freeze(ccstring_table_t* table)
+{
+    if (!table || !table->offsets) {
+        return CCSTRING_FAILURE;
+    }
+
+    if (table->capacity > table->count) {
+        void* offsets = ccstring_realloc(table->offsets, (table->count + 1) * table->offset_width);
+        if (offsets) {
+            table->offsets = offsets;
+            table->capacity = table->count;
+        }
+    }
+
+    if (table->data_capacity > table->data_length && table->data_length > 0) {
+        char* data = (char*)ccstring_realloc(table->data, table->data_length);
+        if (data) {
+            table->data = data;
+            table->data_capacity = table->data_length;
+        }
+    }
+
+    table->frozen = 1;
+    return CCSTRING_SUCCESS;
+}
+
+ccstring_view_t ccstring_table_get(const ccstring_table_t* table, size_t index)
+{
+    ccstring_view_t view = {0};
+
+    if (!table || !table->offsets || index >= table->count) {
+        return view;
+    }
+
+    size_t start = ccstring_table_offset(table, index);
+    size_t end = ccstring_table_offset(table, index + 1);
+    view.buffer = table->data + start;
+    view.length = end - start - 1;
+    return view;
+}
+
+/**
+ * Table file format: a fixed header followed by 8-byte aligned sections.
+*/
+#define CCSTRING_TABLE_MAGIC "CCSTRTBL"
+#define CCSTRING_TABLE_BYTE_ORDER 0x01020304u
+#define CCSTRING_TABLE_ALIGNMENT 8
+
+typedef struct ccstring_table_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t offset_width;
+    uint32_t hash_width;
+    uint64_t count;
+    uint64_t data_length;
+    uint64_t hash_buckets;
+    uint64_t offsets_position;
+    uint64_t data_position;
+    uint64_t hash_position;
+} ccstring_table_header_t;
+
+static uint64_t ccstring_table_hash(const char* str, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= (unsigned char)str[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t ccstring_table_align(uint64_t position)
+{
+    return (position + CCSTRING_TABLE_ALIGNMENT - 1) & ~(uint64_t)(CCSTRING_TABLE_ALIGNMENT - 1);
+}
+
+static uint64_t ccstring_table_hash_slot(const ccstring_table_t* table, size_t bucket)
+{
+    if (table->hash_width == sizeof(uint32_t)) {
+        return ((const uint32_t*)table->hash_index)[bucket];
+    }
+    return ((const uint64_t*)table->hash_index)[bucket];
+}
+
+static int ccstring_table_write_padding(FILE* file, uint64_t* position)
+{
+    static const char zeros[CCSTRING_TABLE_ALIGNMENT] = {0};
+    size_t padding = (size_t)(ccstring_table_align(*position) - *position);
+
+    if (padding > 0 && fwrite(zeros, 1, padding, file) != padding) {
+        return CCSTRING_FAILURE;
+    }
+    *position += padding;
+    return CCSTRING_SUCCESS;
+}
+
+// Builds an open addressing index of entry index + 1, with 0 marking an empty bucket.
+static void* ccstring_table_build_hash(const ccstring_table_t* table, size_t* out_buckets, unsigned int* out_width)
+{
+    size_t buckets = 16;
+    while (buckets < table->count * 2) {
+        buckets *= 2;
+    }
+
+    unsigned int width = table->count < UINT32_MAX ? sizeof(uint32_t) : sizeof(uint64_t);
+    void* index = ccstring_calloc(buckets, width);
+    if (!index) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < table->count; ++i) {
+        ccstring_view_t entry = ccstring_table_get(table, i);
+        size_t bucket = (size_t)(ccstring_table_hash(entry.buffer, entry.length) & (buckets - 1));
+
+        while (width == sizeof(uint32_t) ? ((uint32_t*)index)[bucket] != 0 : ((uint64_t*)index)[bucket] != 0) {
+            bucket = (bucket + 1) & (buckets - 1);
+        }
+
+        if (width == sizeof(uint32_t)) {
+            ((uint32_t*)index)[bucket] = (uint32_t)(i + 1);
+        } else {
+            ((uint64_t*)index)[bucket] = (uint64_t)(i + 1);
+        }
+    }
+
+    *out_buckets = buckets;
+    *out_width = width;
+    return index;
+}
+
+int ccstring_table_find(const ccstring_table_t* table, const char* str, size_t size, size_t* out_index)
+{
+    if (!table || !table->offsets || (!str && size > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    if (table->hash_index && table->hash_buckets > 0) {
+        size_t mask = table->hash_buckets - 1;
+        size_t bucket = (size_t)(ccstring_table_hash(str, size) & mask);
+        uint64_t slot;
+
+        while ((slot = ccstring_table_hash_slot(table, bucket)) != 0) {
+            ccstring_view_t entry = ccstring_table_get(table, (size_t)(slot - 1));
+            if (entry.length == size && (size == 0 || memcmp(entry.buffer, str, size) == 0)) {
+                if (out_index) {
+                    *out_index = (size_t)(slot - 1);
+                }
+                return CCSTRING_SUCCESS;
+            }
+            bucket = (bucket + 1) & mask;
+        }
+        return CCSTRING_FAILURE;
+    }
+
+    for (size_t i = 0; i < table->count; ++i) {
+        ccstring_view_t entry = ccstring_table_get(table, i);
+        if (entry.length == size && (size == 0 || memcmp(entry.buffer, str, size) == 0)) {
+            if (out_index) {
+                *out_index = i;
+            }
+            return CCSTRING_SUCCESS;
+        }
+    }
+    return CCSTRING_FAILURE;
+}
+
+int ccstring_table_write(const ccstring_table_t* table, const char* path, int flags)
+{
+    ccstring_table_header_t header;
+    void* hash_index = NULL;
+    size_t hash_buckets = 0;
+    unsigned int hash_width = 0;
+
+    if (!table || !table->offsets || !path) {
+        return CCSTRING_FAILURE;
+    }
+
+    if (flags & CCSTRING_TABLE_HASH_INDEX) {
+        hash_index = ccstring_table_build_hash(table, &hash_buckets, &hash_width);
+        if (!hash_index) {
+            return CCSTRING_FAILURE;
+        }
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CCSTRING_TABLE_MAGIC, sizeof(header.magic));
+    header.version = CCSTRING_TABLE_FORMAT_VERSION;
+    header.byte_order = CCSTRING_TABLE_BYTE_ORDER;
+    header.offset_width = table->offset_width;
+    header.hash_width = hash_width;
+    header.count = table->count;
+    header.data_length = table->data_length;
+    header.hash_buckets = hash_buckets;
+    header.offsets_position = ccstring_table_align(sizeof(header));
+    header.data_position = ccstring_table_align(header.offsets_position + (table->count + 1) * (uint64_t)table->offset_width);
+    header.hash_position = hash_index ? ccstring_table_align(header.data_position + table->data_length) : 0;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        ccstring_free(hash_index);
+        return CCSTRING_FAILURE;
+    }
+
+    uint64_t position = sizeof(header);
+    int result = fwrite(&header, sizeof(header), 1, file) == 1 ? CCSTRING_SUCCESS : CCSTRING_FAILURE;
+
+    if (result == CCSTRING_SUCCESS) {
+        size_t bytes = (table->count + 1) * table->offset_width;
+        result = ccstring_table_write_padding(file, &position);
+        if (result == CCSTRING_SUCCESS && fwrite(table->offsets, 1, bytes, file) != bytes) {
+            result = CCSTRING_FAILURE;
+        }
+        position += bytes;
+    }
+
+    if (result == CCSTRING_SUCCESS) {
+        result = ccstring_table_write_padding(file, &position);
+        if (result == CCSTRING_SUCCESS && table->data_length > 0 &&
+            fwrite(table->data, 1, table->data_length, file) != table->data_length) {
+            result = CCSTRING_FAILURE;
+        }
+        position += table->data_length;
+    }
+
+    if (result == CCSTRING_SUCCESS && hash_index) {
+        size_t bytes = hash_buckets * hash_width;
+        result = ccstring_table_write_padding(file, &position);
+        if (result == CCSTRING_SUCCESS && fwrite(hash_index, 1, bytes, file) != bytes) {
+            result = CCSTRING_FAILURE;
+        }
+    }
+
+    if (fclose(file) != 0) {
+        result = CCSTRING_FAILURE;
+    }
+    ccstring_free(hash_index);
+    return result;
+}
+
+int ccstring_manager_write(const ccstring_manager_t* mgr, const char* path, int flags)
+{
+    if (!mgr || !path) {
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_table_t table = ccstring_table_new(mgr->count, 0);
+    if (!table.offsets) {
+        return CCSTRING_FAILURE;
+    }
+
+    int result = ccstring_table_append_manager(&table, mgr);
+    if (result == CCSTRING_SUCCESS) {
+        result = ccstring_table_write(&table, path, flags);
+    }
+
+    ccstring_table_destroy(&table);
+    return result;
+}
+
+static void* ccstring_table_map_file(const char* path, size_t* out_size)
+{
+#if defined(CCSTRING_WINDOWS)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LARGE_INTEGER size;
+    void* base = NULL;
+
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && (unsigned long long)size.QuadPart <= SIZE_MAX) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping != NULL) {
+            base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        *out_size = (size_t)size.QuadPart;
+    }
+    CloseHandle(file);
+    return base;
+#else
+    struct stat info;
+    void* base = NULL;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &info) == 0 && info.st_size > 0 && (unsigned long long)info.st_size <= SIZE_MAX) {
+        base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            base = NULL;
+        }
+        *out_size = (size_t)info.st_size;
+    }
+    close(fd);
+    return base;
+#endif
+}
+
+static void ccstring_table_unmap_file(void* base, size_t size)
+{
+#if defined(CCSTRING_WINDOWS)
+    (void)size;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, size);
+#endif
+}
+
+static int ccstring_table_section_fits(uint64_t position, uint64_t bytes, size_t file_size)
+{
+    return position % CCSTRING_TABLE_ALIGNMENT == 0 && position <= file_size && bytes <= file_size - position;
+}
+
+int ccstring_table_map(ccstring_table_t* table, const char* path)
+{
+    size_t size = 0;
+
+    if (!table || !path) {
+        return CCSTRING_FAILURE;
+    }
+
+    unsigned char* base = (unsigned char*)ccstring_table_map_file(path, &size);
+    if (!base) {
+        return CCSTRING_FAILURE;
+    }
+
+    const ccstring_table_header_t* header = (const ccstring_table_header_t*)base;
+    int valid = size >= sizeof(*header) &&
+        memcmp(header->magic, CCSTRING_TABLE_MAGIC, sizeof(header->magic)) == 0 &&
+        header->version == CCSTRING_TABLE_FORMAT_VERSION &&
+        header->byte_order == CCSTRING_TABLE_BYTE_ORDER &&
+        (header->offset_width == sizeof(uint32_t) || header->offset_width == sizeof(uint64_t)) &&
+        header->count < SIZE_MAX / header->offset_width &&
+        ccstring_table_section_fits(header->offsets_position, (header->count + 1) * header->offset_width, size) &&
+        ccstring_table_section_fits(header->data_position, header->data_length, size);
+
+    if (valid && header->hash_buckets > 0) {
+        valid = (header->hash_width == sizeof(uint32_t) || header->hash_width == sizeof(uint64_t)) &&
+            (header->hash_buckets & (header->hash_buckets - 1)) == 0 &&
+            header->hash_buckets < SIZE_MAX / header->hash_width &&
+            ccstring_table_section_fits(header->hash_position, header->hash_buckets * header->hash_width, size);
+    }
+
+    if (!valid) {
+        ccstring_table_unmap_file(base, size);
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_table_t mapped = {0};
+    mapped.data = (char*)(base + header->data_position);
+    mapped.data_length = (size_t)header->data_length;
+    mapped.data_capacity = (size_t)header->data_length;
+    mapped.offsets = base + header->offsets_position;
+    mapped.count = (size_t)header->count;
+    mapped.capacity = (size_t)header->count;
+    mapped.offset_width = header->offset_width;
+    mapped.frozen = 1;
+    mapped.mapping = base;
+    mapped.mapping_size = size;
+
+    if (ccstring_table_offset(&mapped, 0) != 0 || ccstring_table_offset(&mapped, mapped.count) != mapped.data_length) {
+        ccstring_table_unmap_file(base, size);
+        return CCSTRING_FAILURE;
+    }
+
+    if (header->hash_buckets > 0) {
+        mapped.hash_index = base + header->hash_position;
+        mapped.hash_buckets = (size_t)header->hash_buckets;
+        mapped.hash_width = header->hash_width;
+    }
+
+    *table = mapped;
+    return CCSTRING_SUCCESS;
+}
+
+void ccstring_table_destroy(ccstring_table_t* table)
+{
+    if (!table) return;
+
+    if (table->mapping) {
+        ccstring_table_unmap_file(table->mapping, table->mapping_size);
+    } else {
+        ccstring_free(table->data);
+        ccstring_free(table->offsets);
+    }
+
+    memset(table, 0, sizeof(*table));
+}
+
+/**
+ * Radix tree: adaptive inner nodes (4/16/48/256 children) with full compressed prefixes.
+ * Every child pointer refers to either a leaf or an inner node; both start with their type byte.
+ * Prefixes point into the key of a leaf below the node, which stays valid because entries are never removed.
+*/
+#define CCSTRING_RADIX_LEAF 0
+#define CCSTRING_RADIX_NODE4 1
+#define CCSTRING_RADIX_NODE16 2
+#define CCSTRING_RADIX_NODE48 3
+#define CCSTRING_RADIX_NODE256 4
+
+typedef struct ccstring_radix_leaf {
+    unsigned char type;
+    const unsigned char* key;
+    size_t length;
+    void* value;
+} ccstring_radix_leaf_t;
+
+typedef struct ccstring_radix_node {
+    unsigned char type;
+    unsigned short children;
+    size_t prefix_length;
+    const unsigned char* prefix;
+    ccstring_radix_leaf_t* terminal;
+} ccstring_radix_node_t;
+
+typedef struct ccstring_radix_node4 {
+    ccstring_radix_node_t base;
+    unsigned char keys[4];
+    void* child[4];
+} ccstring_radix_node4_t;
+
+typedef struct ccstring_radix_node16 {
+    ccstring_radix_node_t base;
+    unsigned char keys[16];
+    void* child[16];
+} ccstring_radix_node16_t;
+
+typedef struct ccstring_radix_node48 {
+    ccstring_radix_node_t base;
+    unsigned char index[256];
+    void* child[48];
+} ccstring_radix_node48_t;
+
+typedef struct ccstring_radix_node256 {
+    ccstring_radix_node_t base;
+    void* child[256];
+} ccstring_radix_node256_t;
+
+static unsigned char ccstring_radix_type(const void* item)
+{
+    return *(const unsigned char*)item;
+}
+
+// Appends a freshly created string to the manager list without the duplicate scan of ccstring_manager_add.
+static int ccstring_manager_push(ccstring_manager_t* mgr, ccstring_t* str)
+{
+    if (mgr->count >= mgr->capacity || !mgr->list) {
+        size_t new_capacity = mgr->capacity > 0 ? mgr->capacity * 2 : 16;
+        ccstring_t** temp = (ccstring_t**)ccstring_realloc(mgr->list, new_capacity * sizeof(*temp));
+        if (!temp) {
+            return CCSTRING_FAILURE;
+        }
+        mgr->list = temp;
+        mgr->capacity = new_capacity;
+        CCSTRING_STATS_ADD(manager_growths, 1);
+    }
+
+    mgr->list[mgr->count++] = str;
+    CCSTRING_STATS_RECORD_MANAGER(mgr);
+    return CCSTRING_SUCCESS;
+}
+
+static ccstring_radix_leaf_t* ccstring_radix_leaf_new(ccstring_radix_t* tree, const ccstring_view_t* key, void* value)
+{
+    ccstring_radix_leaf_t* leaf = (ccstring_radix_leaf_t*)ccstring_malloc(sizeof(*leaf));
+    if (!leaf) {
+        return NULL;
+    }
+
+    leaf->type = CCSTRING_RADIX_LEAF;
+    leaf->key = (const unsigned char*)key->buffer;
+    leaf->length = key->length;
+    leaf->value = value;
+
+    if (tree->mgr) {
+        ccstring_t* copy = ccstring_new(key->buffer, key->length);
+        if (!copy || ccstring_manager_push(tree->mgr, copy) != CCSTRING_SUCCESS) {
+            ccstring_destroy(&copy);
+            ccstring_free(leaf);
+            return NULL;
+        }
+        leaf->key = (const unsigned char*)copy->buffer;
+    }
+
+    return leaf;
+}
+
+// Undoes ccstring_radix_leaf_new when a later allocation fails.
+static void ccstring_radix_leaf_discard(ccstring_radix_t* tree, ccstring_radix_leaf_t* leaf)
+{
+    if (tree->mgr) {
+        ccstring_t* copy = NULL;
+        ccstring_manager_remove(tree->mgr, tree->mgr->count - 1, &copy);
+        ccstring_destroy(&copy);
+    }
+    ccstring_free(leaf);
+}
+
+static ccstring_radix_node_t* ccstring_radix_node_new(unsigned char type)
+{
+    size_t size;
+
+    switch (type) {
+    case CCSTRING_RADIX_NODE4:
+        size = sizeof(ccstring_radix_node4_t);
+        break;
+    case CCSTRING_RADIX_NODE16:
+        size = sizeof(ccstring_radix_node16_t);
+        break;
+    case CCSTRING_RADIX_NODE48:
+        size = sizeof(ccstring_radix_node48_t);
+        break;
+    default:
+        size = sizeof(ccstring_radix_node256_t);
+        break;
+    }
+
+    ccstring_radix_node_t* node = (ccstring_radix_node_t*)ccstring_calloc(1, size);
+    if (node) {
+        node->type = type;
+    }
+    return node;
+}
+
+static void** ccstring_radix_find_child(ccstring_radix_node_t* node, unsigned char byte)
+{
+    switch (node->type) {
+    case CCSTRING_RADIX_NODE4: {
+        ccstring_radix_node4_t* n = (ccstring_radix_node4_t*)node;
+        for (unsigned int i = 0; i < node->children; ++i) {
+            if (n->keys[i] == byte) {
+                return &n->child[i];
+            }
+        }
+        return NULL;
+    }
+    case CCSTRING_RADIX_NODE16: {
+        ccstring_radix_node16_t* n = (ccstring_radix_node16_t*)node;
+#if defined(CCSTRING_SSE2)
+        __m128i keys = _mm_loadu_si128((const __m128i*)n->keys);
+        __m128i match = _mm_cmpeq_epi8(keys, _mm_set1_epi8((char)byte));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(match) & ((1u << node->children) - 1u);
+        return mask ? &n->child[ccstring_ctz32(mask)] : NULL;
+#else
+        for (unsigned int i = 0; i < node->children; ++i) {
+            if (n->keys[i] == byte) {
+                return &n->child[i];
+            }
+        }
+        return NULL;
+#endif
+    }
+    case CCSTRING_RADIX_NODE48: {
+        ccstring_radix_node48_t* n = (ccstring_radix_node48_t*)node;
+        return n->index[byte] ? &n->child[n->index[byte] - 1] : NULL;
+    }
+    default: {
+        ccstring_radix_node256_t* n = (ccstring_radix_node256_t*)node;
+        return n->child[byte] ? &n->child[byte] : NULL;
+    }
+    }
+}
+
+// Inserts into the sorted key/child arrays shared by the 4 and 16 child layouts.
+static void ccstring_radix_insert_sorted(unsigned char* keys, void** child, unsigned int count, unsigned char byte, void* item)
+{
+    unsigned int position = count;
+    while (position > 0 && keys[position - 1] > byte) {
+        keys[position] = keys[position - 1];
+        child[position] = child[position - 1];
+        --position;
+    }
+    keys[position] = byte;
+    child[position] = item;
+}
+
+// Adds a child that is known to be missing, growing the node into the next layout when it is full.
+static int ccstring_radix_add_child(void** ref, ccstring_radix_node_t* node, unsigned char byte, void* item)
+{
+    switch (node->type) {
+    case CCSTRING_RADIX_NODE4: {
+        ccstring_radix_node4_t* n = (ccstring_radix_node4_t*)node;
+        if (node->children < 4) {
+            ccstring_radix_insert_sorted(n->keys, n->child, node->children++, byte, item);
+            return CCSTRING_SUCCESS;
+        }
+
+        ccstring_radix_node16_t* grown = (ccstring_radix_node16_t*)ccstring_radix_node_new(CCSTRING_RADIX_NODE16);
+        if (!grown) {
+            return CCSTRING_FAILURE;
+        }
+        grown->base = n->base;
+        grown->base.type = CCSTRING_RADIX_NODE16;
+        memcpy(grown->keys, n->keys, sizeof(n->keys));
+        memcpy(grown->child, n->child, sizeof(n->child));
+        ccstring_free(n);
+        *ref = grown;
+        ccstring_radix_insert_sorted(grown->keys, grown->child, grown->base.children++, byte, item);
+        return CCSTRING_SUCCESS;
+    }
+    case CCSTRING_RADIX_NODE16: {
+        ccstring_radix_node16_t* n = (ccstring_radix_node16_t*)node;
+        if (node->children < 16) {
+            ccstring_radix_insert_sorted(n->keys, n->child, node->children++, byte, item);
+            return CCSTRING_SUCCESS;
+        }
+
+        ccstring_radix_node48_t* grown = (ccstring_radix_node48_t*)ccstring_radix_node_new(CCSTRING_RADIX_NODE48);
+        if (!grown) {
+            return CCSTRING_FAILURE;
+        }
+        grown->base = n->base;
+        grown->base.type = CCSTRING_RADIX_NODE48;
+        for (unsigned int i = 0; i < 16; ++i) {
+            grown->child[i] = n->child[i];
+            grown->index[n->keys[i]] = (unsigned char)(i + 1);
+        }
+        ccstring_free(n);
+        *ref = grown;
+        grown->child[grown->base.children] = item;
+        grown->index[byte] = (unsigned char)(++grown->base.children);
+        return CCSTRING_SUCCESS;
+    }
+    case CCSTRING_RADIX_NODE48: {
+        ccstring_radix_node48_t* n = (ccstring_radix_node48_t*)node;
+        if (node->children < 48) {
+            n->child[node->children] = item;
+            n->index[byte] = (unsigned char)(++node->children);
+            return CCSTRING_SUCCESS;
+        }
+
+        ccstring_radix_node256_t* grown = (ccstring_radix_node256_t*)ccstring_radix_node_new(CCSTRING_RADIX_NODE256);
+        if (!grown) {
+            return CCSTRING_FAILURE;
+        }
+        grown->base = n->base;
+        grown->base.type = CCSTRING_RADIX_NODE256;
+        for (unsigned int b = 0; b < 256; ++b) {
+            if (n->index[b]) {
+                grown->child[b] = n->child[n->index[b] - 1];
+            }
+        }
+        ccstring_free(n);
+        *ref = grown;
+        grown->child[byte] = item;
+        grown->base.children++;
+        return CCSTRING_SUCCESS;
+    }
+    default: {
+        ccstring_radix_node256_t* n = (ccstring_radix_node256_t*)node;
+        n->child[byte] = item;
+        node->children++;
+        return CCSTRING_SUCCESS;
+    }
+    }
+}
+
+// Hangs a leaf below a node whose prefix ends at depth.
+static void ccstring_radix_place_leaf(ccstring_radix_node_t* node, ccstring_radix_leaf_t* leaf, size_t depth)
+{
+    if (leaf->length == depth) {
+        node->terminal = leaf;
+    } else {
+        ccstring_radix_node4_t* n = (ccstring_radix_node4_t*)node;
+        ccstring_radix_insert_sorted(n->keys, n->child, node->children++, leaf->key[depth], leaf);
+    }
+}
+
+static int ccstring_radix_insert_at(ccstring_radix_t* tree, void** ref, const ccstring_view_t* key, void* value, size_t depth)
+{
+    const unsigned char* bytes = (const unsigned char*)key->buffer;
+    size_t length = key->length;
+
+    for (;;) {
+        if (*ref == NULL) {
+            ccstring_radix_leaf_t* leaf = ccstring_radix_leaf_new(tree, key, value);
+            if (!leaf) {
+                return CCSTRING_FAILURE;
+            }
+            *ref = leaf;
+            tree->count++;
+            return CCSTRING_SUCCESS;
+        }
+
+        if (ccstring_radix_type(*ref) == CCSTRING_RADIX_LEAF) {
+            ccstring_radix_leaf_t* existing = (ccstring_radix_leaf_t*)*ref;
+            if (existing->length == length && memcmp(existing->key + depth, bytes + depth, length - depth) == 0) {
+                existing->value = value;
+                return CCSTRING_SUCCESS;
+            }
+
+            ccstring_radix_leaf_t* leaf = ccstring_radix_leaf_new(tree, key, value);
+            ccstring_radix_node_t* node = leaf ? ccstring_radix_node_new(CCSTRING_RADIX_NODE4) : NULL;
+            if (!node) {
+                if (leaf) {
+                    ccstring_radix_leaf_discard(tree, leaf);
+                }
+                return CCSTRING_FAILURE;
+            }
+
+            size_t limit = (existing->length < length ? existing->length : length) - depth;
+            size_t common = 0;
+            while (common < limit && existing->key[depth + common] == leaf->key[depth + common]) {
+                ++common;
+            }
+
+            node->prefix = leaf->key + depth;
+            node->prefix_length = common;
+            ccstring_radix_place_leaf(node, existing, depth + common);
+            ccstring_radix_place_leaf(node, leaf, depth + common);
+            *ref = node;
+            tree->count++;
+            return CCSTRING_SUCCESS;
+        }
+
+        ccstring_radix_node_t* node = (ccstring_radix_node_t*)*ref;
+        if (node->prefix_length > 0) {
+            size_t limit = length - depth < node->prefix_length ? length - depth : node->prefix_length;
+            size_t common = 0;
+            while (common < limit && node->prefix[common] == bytes[depth + common]) {
+                ++common;
+            }
+
+            if (common < node->prefix_length) {
+                // The key diverges inside the compressed prefix: split it with a new parent node.
+                ccstring_radix_leaf_t* leaf = ccstring_radix_leaf_new(tree, key, value);
+                ccstring_radix_node_t* parent = leaf ? ccstring_radix_node_new(CCSTRING_RADIX_NODE4) : NULL;
+                if (!parent) {
+                    if (leaf) {
+                        ccstring_radix_leaf_discard(tree, leaf);
+                    }
+                    return CCSTRING_FAILURE;
+                }
+
+                ccstring_radix_node4_t* p = (ccstring_radix_node4_t*)parent;
+                parent->prefix = node->prefix;
+                parent->prefix_length = common;
+                ccstring_radix_insert_sorted(p->keys, p->child, parent->children++, node->prefix[common], node);
+                node->prefix += common + 1;
+                node->prefix_length -= common + 1;
+                ccstring_radix_place_leaf(parent, leaf, depth + common);
+                *ref = parent;
+                tree->count++;
+                return CCSTRING_SUCCESS;
+            }
+            depth += node->prefix_length;
+        }
+
+        if (depth == length) {
+            if (node->terminal) {
+                node->terminal->value = value;
+                return CCSTRING_SUCCESS;
+            }
+            node->terminal = ccstring_radix_leaf_new(tree, key, value);
+            if (!node->terminal) {
+                return CCSTRING_FAILURE;
+            }
+            tree->count++;
+            return CCSTRING_SUCCESS;
+        }
+
+        void** child = ccstring_radix_find_child(node, bytes[depth]);
+        if (!child) {
+            ccstring_radix_leaf_t* leaf = ccstring_radix_leaf_new(tree, key, value);
+            if (!leaf) {
+                return CCSTRING_FAILURE;
+            }
+            if (ccstring_radix_add_child(ref, node, bytes[depth], leaf) != CCSTRING_SUCCESS) {
+                ccstring_radix_leaf_discard(tree, leaf);
+                return CCSTRING_FAILURE;
+            }
+            tree->count++;
+            return CCSTRING_SUCCESS;
+        }
+
+        ref = child;
+        ++depth;
+    }
+}
+
+ccstring_radix_t ccstring_radix_new(ccstring_manager_t* mgr)
+{
+    ccstring_radix_t tree = {0};
+    tree.mgr = mgr;
+    return tree;
+}
+
+int ccstring_radix_insert(ccstring_radix_t* tree, const ccstring_view_t* key, void* value)
+{
+    if (!tree || !key || (!key->buffer && key->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    return ccstring_radix_insert_at(tree, &tree->root, key, value, 0);
+}
+
+int ccstring_radix_find(const ccstring_radix_t* tree, const ccstring_view_t* key, void** out_value)
+{
+    if (!tree || !key || (!key->buffer && key->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)key->buffer;
+    void* item = tree->root;
+    size_t depth = 0;
+
+    while (item) {
+        if (ccstring_radix_type(item) == CCSTRING_RADIX_LEAF) {
+            const ccstring_radix_leaf_t* leaf = (const ccstring_radix_leaf_t*)item;
+            if (leaf->length != key->length || memcmp(leaf->key + depth, bytes + depth, key->length - depth) != 0) {
+                return CCSTRING_FAILURE;
+            }
+            if (out_value) {
+                *out_value = leaf->value;
+            }
+            return CCSTRING_SUCCESS;
+        }
+
+        ccstring_radix_node_t* node = (ccstring_radix_node_t*)item;
+        if (key->length - depth < node->prefix_length ||
+            memcmp(node->prefix, bytes + depth, node->prefix_length) != 0) {
+            return CCSTRING_FAILURE;
+        }
+        depth += node->prefix_length;
+
+        if (depth == key->length) {
+            if (!node->terminal) {
+                return CCSTRING_FAILURE;
+            }
+            if (out_value) {
+                *out_value = node->terminal->value;
+            }
+            return CCSTRING_SUCCESS;
+        }
+
+        void** child = ccstring_radix_find_child(node, bytes[depth]);
+        item = child ? *child : NULL;
+        ++depth;
+    }
+
+    return CCSTRING_FAILURE;
+}
+
+int ccstring_radix_longest_prefix(const ccstring_radix_t* tree, const ccstring_view_t* key, ccstring_view_t* out_key, void** out_value)
+{
+    if (!tree || !key || (!key->buffer && key->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)key->buffer;
+    const ccstring_radix_leaf_t* best = NULL;
+    void* item = tree->root;
+    size_t depth = 0;
+
+    while (item) {
+        if (ccstring_radix_type(item) == CCSTRING_RADIX_LEAF) {
+            const ccstring_radix_leaf_t* leaf = (const ccstring_radix_leaf_t*)item;
+            if (leaf->length <= key->length && memcmp(leaf->key + depth, bytes + depth, leaf->length - depth) == 0) {
+                best = leaf;
+            }
+            break;
+        }
+
+        ccstring_radix_node_t* node = (ccstring_radix_node_t*)item;
+        if (key->length - depth < node->prefix_length ||
+            memcmp(node->prefix, bytes + depth, node->prefix_length) != 0) {
+            break;
+        }
+        depth += node->prefix_length;
+
+        if (node->terminal) {
+            best = node->terminal;
+        }
+        if (depth == key->length) {
+            break;
+        }
+
+        void** child = ccstring_radix_find_child(node, bytes[depth]);
+        item = child ? *child : NULL;
+        ++depth;
+    }
+
+    if (!best) {
+        return CCSTRING_FAILURE;
+    }
+    if (out_key) {
+        out_key->buffer = (const char*)best->key;
+        out_key->length = best->length;
+    }
+    if (out_value) {
+        *out_value = best->value;
+    }
+    return CCSTRING_SUCCESS;
+}
+
+static int ccstring_radix_visit_leaf(const ccstring_radix_leaf_t* leaf, ccstring_radix_visit_fn visit, void* context)
+{
+    ccstring_view_t key;
+    key.buffer = (const char*)leaf->key;
+    key.length = leaf->length;
+    return visit(&key, leaf->value, context);
+}
+
+static int ccstring_radix_visit_all(const void* item, ccstring_radix_visit_fn visit, void* context)
+{
+    if (ccstring_radix_type(item) == CCSTRING_RADIX_LEAF) {
+        return ccstring_radix_visit_leaf((const ccstring_radix_leaf_t*)item, visit, context);
+    }
+
+    const ccstring_radix_node_t* node = (const ccstring_radix_node_t*)item;
+    int result = 0;
+
+    if (node->terminal) {
+        result = ccstring_radix_visit_leaf(node->terminal, visit, context);
+    }
+
+    switch (node->type) {
+    case CCSTRING_RADIX_NODE4: {
+        const ccstring_radix_node4_t* n = (const ccstring_radix_node4_t*)node;
+        for (unsigned int i = 0; i < node->children && result == 0; ++i) {
+            result = ccstring_radix_visit_all(n->child[i], visit, context);
+        }
+        break;
+    }
+    case CCSTRING_RADIX_NODE16: {
+        const ccstring_radix_node16_t* n = (const ccstring_radix_node16_t*)node;
+        for (unsigned int i = 0; i < node->children && result == 0; ++i) {
+            result = ccstring_radix_visit_all(n->child[i], visit, context);
+        }
+        break;
+    }
+    case CCSTRING_RADIX_NODE48: {
+        const ccstring_radix_node48_t* n = (const ccstring_radix_node48_t*)node;
+        for (unsigned int b = 0; b < 256 && result == 0; ++b) {
+            if (n->index[b]) {
+                result = ccstring_radix_visit_all(n->child[n->index[b] - 1], visit, context);
+            }
+        }
+        break;
+    }
+    default: {
+        const ccstring_radix_node256_t* n = (const ccstring_radix_node256_t*)node;
+        for (unsigned int b = 0; b < 256 && result == 0; ++b) {
+            if (n->child[b]) {
+                result = ccstring_radix_visit_all(n->child[b], visit, context);
+            }
+        }
+        break;
+    }
+    }
+
+    return result;
+}
+
+int ccstring_radix_iterate_prefix(const ccstring_radix_t* tree, const ccstring_view_t* prefix, ccstring_radix_visit_fn visit, void* context)
+{
+    if (!tree || !prefix || !visit || (!prefix->buffer && prefix->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)prefix->buffer;
+    void* item = tree->root;
+    size_t depth = 0;
+
+    while (item) {
+        if (ccstring_radix_type(item) == CCSTRING_RADIX_LEAF) {
+            const ccstring_radix_leaf_t* leaf = (const ccstring_radix_leaf_t*)item;
+            if (leaf->length >= prefix->length && memcmp(leaf->key + depth, bytes + depth, prefix->length - depth) == 0) {
+                return ccstring_radix_visit_leaf(leaf, visit, context);
+            }
+            return CCSTRING_SUCCESS;
+        }
+
+        ccstring_radix_node_t* node = (ccstring_radix_node_t*)item;
+        size_t remaining = prefix->length - depth;
+        size_t compared = remaining < node->prefix_length ? remaining : node->prefix_length;
+        if (memcmp(node->prefix, bytes + depth, compared) != 0) {
+            return CCSTRING_SUCCESS;
+        }
+        if (remaining <= node->prefix_length) {
+            return ccstring_radix_visit_all(node, visit, context);
+        }
+        depth += node->prefix_length;
+
+        void** child = ccstring_radix_find_child(node, bytes[depth]);
+        item = child ? *child : NULL;
+        ++depth;
+    }
+
+    return CCSTRING_SUCCESS;
+}
+
+static void ccstring_radix_free(void* item)
+{
+    if (ccstring_radix_type(item) == CCSTRING_RADIX_LEAF) {
+        ccstring_free(item);
+        return;
+    }
+
+    ccstring_radix_node_t* node = (ccstring_radix_node_t*)item;
+    ccstring_free(node->terminal);
+
+    switch (node->type) {
+    case CCSTRING_RADIX_NODE4: {
+        ccstring_radix_node4_t* n = (ccstring_radix_node4_t*)node;
+        for (unsigned int i = 0; i < node->children; ++i) {
+            ccstring_radix_free(n->child[i]);
+        }
+        break;
+    }
+    case CCSTRING_RADIX_NODE16: {
+        ccstring_radix_node16_t* n = (ccstring_radix_node16_t*)node;
+        for (unsigned int i = 0; i < node->children; ++i) {
+            ccstring_radix_free(n->child[i]);
+        }
+        break;
+    }
+    case CCSTRING_RADIX_NODE48: {
+        ccstring_radix_node48_t* n = (ccstring_radix_node48_t*)node;
+        for (unsigned int i = 0; i < node->children; ++i) {
+            ccstring_radix_free(n->child[i]);
+        }
+        break;
+    }
+    default: {
+        ccstring_radix_node256_t* n = (ccstring_radix_node256_t*)node;
+        for (unsigned int b = 0; b < 256; ++b) {
+            if (n->child[b]) {
+                ccstring_radix_free(n->child[b]);
+            }
+        }
+        break;
+    }
+    }
+
+    ccstring_free(node);
+}
+
+void ccstring_radix_destroy(ccstring_radix_t* tree)
+{
+    if (!tree) return;
+
+    if (tree->root) {
+        ccstring_radix_free(tree->root);
+    }
+    tree->root = NULL;
+    tree->count = 0;
+}
+
+/**
+ * Hex and base64 codecs. Output is sized exactly up front and written straight into the string buffer;
+ * the SSSE3 kernels handle whole blocks and the scalar loops finish the tail.
+*/
+static const char ccstring_hex_lower[] = "0123456789abcdef";
+static const char ccstring_hex_upper[] = "0123456789ABCDEF";
+static const char ccstring_base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+#if defined(CCSTRING_SSSE3)
+static int ccstring_cpu_has_ssse3(void)
+{
+#if defined(__SSSE3__)
+    return 1;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("ssse3");
+#else
+    static volatile int cached = -1;
+    if (cached < 0) {
+        int info[4];
+        __cpuid(info, 1);
+        cached = (info[2] >> 9) & 1;
+    }
+    return cached;
+#endif
+}
+
+// Encodes whole 16-byte blocks and returns the number of input bytes consumed.
+CCSTRING_TARGET_SSSE3
+static size_t ccstring_hex_encode_ssse3(const unsigned char* in, size_t size, char* out, const char* digits)
+{
+    const __m128i lut = _mm_loadu_si128((const __m128i*)digits);
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(bytes, mask));
+        _mm_storeu_si128((__m128i*)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+// Maps 16 hex characters to their values; valid gets 0xff in every lane holding a hex digit.
+CCSTRING_TARGET_SSSE3
+static __m128i ccstring_hex_nibbles_ssse3(__m128i chars, __m128i* valid)
+{
+    __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+    *valid = _mm_or_si128(is_digit, is_letter);
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+// Decodes whole 32-character blocks and returns the number of output bytes written.
+// Stops before the first block containing an invalid character and leaves it to the scalar loop.
+CCSTRING_TARGET_SSSE3
+static size_t ccstring_hex_decode_ssse3(const unsigned char* in, size_t out_size, unsigned char* out)
+{
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    size_t i = 0;
+
+    for (; i + 16 <= out_size; i += 16) {
+        __m128i valid_a;
+        __m128i valid_b;
+        __m128i a = ccstring_hex_nibbles_ssse3(_mm_loadu_si128((const __m128i*)(in + 2 * i)), &valid_a);
+        __m128i b = ccstring_hex_nibbles_ssse3(_mm_loadu_si128((const __m128i*)(in + 2 * i + 16)), &valid_b);
+        if (_mm_movemask_epi8(_mm_and_si128(valid_a, valid_b)) != 0xffff) {
+            break;
+        }
+        // Each pair of nibbles becomes high * 16 + low in a 16-bit lane, then packs back to bytes.
+        a = _mm_maddubs_epi16(a, weights);
+        b = _mm_maddubs_epi16(b, weights);
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi16(a, b));
+    }
+    return i;
+}
+
+// Encodes 12 input bytes into 16 characters per step; each step loads 16 bytes, so 16 must be readable.
+CCSTRING_TARGET_SSSE3
+static size_t ccstring_base64_encode_ssse3(const unsigned char* in, size_t size, char* out)
+{
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    size_t i = 0;
+    size_t o = 0;
+
+    for (; i + 16 <= size; i += 12, o += 16) {
+        __m128i bytes = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(in + i)), shuffle);
+        // Split each 3-byte group into four 6-bit indices, one per byte lane.
+        __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        __m128i t1 = _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t0, t1);
+        // Map 0..25, 26..51, 52..61, 62 and 63 to the offset that turns each index into its character.
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+        _mm_storeu_si128((__m128i*)(out + o), _mm_add_epi8(_mm_shuffle_epi8(shift_lut, range), indices));
+    }
+    return i;
+}
+
+// Decodes 16 characters into 12 bytes per step and returns the number of characters consumed.
+// Each step stores 16 bytes, so it only runs while at least 24 characters remain.
+// Stops before the first block containing a byte outside the alphabet.
+CCSTRING_TARGET_SSSE3
+static size_t ccstring_base64_decode_ssse3(const unsigned char* in, size_t length, unsigned char* out)
+{
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    const __m128i slash = _mm_set1_epi8('/');
+    const __m128i gather = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    size_t o = 0;
+
+    for (; length - i >= 24; i += 16, o += 12) {
+        __m128i chars = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), mask);
+        __m128i lo_nibbles = _mm_and_si128(chars, mask);
+        // A character is valid when the classes selected by its two nibbles do not overlap.
+        __m128i classes = _mm_and_si128(_mm_shuffle_epi8(lut_lo, lo_nibbles), _mm_shuffle_epi8(lut_hi, hi_nibbles));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(classes, _mm_setzero_si128())) != 0) {
+            break;
+        }
+        __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(chars, slash), hi_nibbles));
+        __m128i values = _mm_add_epi8(chars, roll);
+        // Merge four 6-bit values into three bytes per 32-bit lane, then pack the lanes together.
+        __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i*)(out + o), _mm_shuffle_epi8(merged, gather));
+    }
+    return i;
+}
+#endif
+
+static int ccstring_hex_value(unsigned char c)
+{
+    if ((unsigned char)(c - '0') < 10) {
+        return c - '0';
+    }
+    c |= 0x20;
+    if ((unsigned char)(c - 'a') < 6) {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+static int ccstring_base64_value(unsigned char c)
+{
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+// Grows str so that extra more bytes fit after the current contents.
+static int ccstring_reserve_extra(ccstring_t* str, size_t extra)
+{
+    if (extra > SIZE_MAX - 1 - str->length) {
+        return CCSTRING_FAILURE;
+    }
+    return ccstring_reserve_internal(str, str->length + extra);
+}
+
+static void ccstring_commit_extra(ccstring_t* str, size_t extra)
+{
+    str->length += extra;
+    str->buffer[str->length] = CCSTRING_NULL_TERMINATER;
+}
+
+int ccstring_append_hex(ccstring_t** str, const void* data, size_t size, int flags)
+{
+    if (!str || !*str || (!data && size > 0) || size > SIZE_MAX / 2) {
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_t* target = *str;
+    if (ccstring_reserve_extra(target, size * 2) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* in = (const unsigned char*)data;
+    const char* digits = (flags & CCSTRING_HEX_UPPERCASE) ? ccstring_hex_upper : ccstring_hex_lower;
+    char* out = target->buffer + target->length;
+    size_t i = 0;
+
+#if defined(CCSTRING_SSSE3)
+    if (ccstring_cpu_has_ssse3()) {
+        i = ccstring_hex_encode_ssse3(in, size, out, digits);
+    }
+#endif
+    for (; i < size; ++i) {
+        out[2 * i] = digits[in[i] >> 4];
+        out[2 * i + 1] = digits[in[i] & 0x0f];
+    }
+
+    CCSTRING_STATS_ADD(bytes_copied, size * 2);
+    ccstring_commit_extra(target, size * 2);
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_append_hex_decoded(ccstring_t** str, const ccstring_view_t* text)
+{
+    if (!str || !*str || !text || (!text->buffer && text->length > 0) || text->length % 2 != 0) {
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_t* target = *str;
+    size_t out_size = text->length / 2;
+    if (ccstring_reserve_extra(target, out_size) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* in = (const unsigned char*)text->buffer;
+    unsigned char* out = (unsigned char*)target->buffer + target->length;
+    size_t i = 0;
+
+#if defined(CCSTRING_SSSE3)
+    if (ccstring_cpu_has_ssse3()) {
+        i = ccstring_hex_decode_ssse3(in, out_size, out);
+    }
+#endif
+    for (; i < out_size; ++i) {
+        int hi = ccstring_hex_value(in[2 * i]);
+        int lo = ccstring_hex_value(in[2 * i + 1]);
+        if (hi < 0 || lo < 0) {
+            target->buffer[target->length] = CCSTRING_NULL_TERMINATER;
+            return CCSTRING_FAILURE;
+        }
+        out[i] = (unsigned char)((hi << 4) | lo);
+    }
+
+    CCSTRING_STATS_ADD(bytes_copied, out_size);
+    ccstring_commit_extra(target, out_size);
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_append_base64(ccstring_t** str, const void* data, size_t size)
+{
+    if (!str || !*str || (!data && size > 0) || size > SIZE_MAX / 2) {
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_t* target = *str;
+    size_t out_size = (size + 2) / 3 * 4;
+    if (ccstring_reserve_extra(target, out_size) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* in = (const unsigned char*)data;
+    char* out = target->buffer + target->length;
+    size_t i = 0;
+
+#if defined(CCSTRING_SSSE3)
+    if (ccstring_cpu_has_ssse3()) {
+        i = ccstring_base64_encode_ssse3(in, size, out);
+    }
+#endif
+    char* cursor = out + i / 3 * 4;
+    for (; i + 3 <= size; i += 3) {
+        uint32_t group = ((uint32_t)in[i] << 16) | ((uint32_t)in[i + 1] << 8) | in[i + 2];
+        cursor[0] = ccstring_base64_alphabet[group >> 18];
+        cursor[1] = ccstring_base64_alphabet[(group >> 12) & 0x3f];
+        cursor[2] = ccstring_base64_alphabet[(group >> 6) & 0x3f];
+        cursor[3] = ccstring_base64_alphabet[group & 0x3f];
+        cursor += 4;
+    }
+    if (i < size) {
+        uint32_t group = (uint32_t)in[i] << 16;
+        if (i + 1 < size) {
+            group |= (uint32_t)in[i + 1] << 8;
+        }
+        cursor[0] = ccstring_base64_alphabet[group >> 18];
+        cursor[1] = ccstring_base64_alphabet[(group >> 12) & 0x3f];
+        cursor[2] = i + 1 < size ? ccstring_base64_alphabet[(group >> 6) & 0x3f] : '=';
+        cursor[3] = '=';
+    }
+
+    CCSTRING_STATS_ADD(bytes_copied, out_size);
+    ccstring_commit_extra(target, out_size);
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_append_base64_decoded(ccstring_t** str, const ccstring_view_t* text)
+{
+    if (!str || !*str || !text || (!text->buffer && text->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* in = (const unsigned char*)text->buffer;
+    size_t length = text->length;
+
+    // Padding is only allowed to complete the final group of four.
+    if (length > 0 && length % 4 == 0) {
+        if (in[length - 1] == '=') {
+            --length;
+            if (in[length - 1] == '=') {
+                --length;
+            }
+        }
+    }
+    if (length % 4 == 1) {
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_t* target = *str;
+    size_t out_size = length / 4 * 3 + (length % 4 ? length % 4 - 1 : 0);
+    if (ccstring_reserve_extra(target, out_size) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    unsigned char* out = (unsigned char*)target->buffer + target->length;
+    size_t i = 0;
+
+#if defined(CCSTRING_SSSE3)
+    if (ccstring_cpu_has_ssse3()) {
+        i = ccstring_base64_decode_ssse3(in, length, out);
+    }
+#endif
+    unsigned char* cursor = out + i / 4 * 3;
+    for (; i < length; i += 4) {
+        size_t group_length = length - i < 4 ? length - i : 4;
+        uint32_t group = 0;
+        for (size_t k = 0; k < 4; ++k) {
+            int value = k < group_length ? ccstring_base64_value(in[i + k]) : 0;
+            if (value < 0) {
+                target->buffer[target->length] = CCSTRING_NULL_TERMINATER;
+                return CCSTRING_FAILURE;
+            }
+            group = (group << 6) | (uint32_t)value;
+        }
+        cursor[0] = (unsigned char)(group >> 16);
+        if (group_length > 2) {
+            cursor[1] = (unsigned char)(group >> 8);
+        }
+        if (group_length > 3) {
+            cursor[2] = (unsigned char)group;
+        }
+        cursor += group_length - 1;
+    }
+
+    CCSTRING_STATS_ADD(bytes_copied, out_size);
+    ccstring_commit_extra(target, out_size);
+    return CCSTRING_SUCCESS;
+}
+
+/**
+ * JSON and CSV escaping. A vector scan finds the next byte that needs attention and the clean run
+ * before it is copied with memcpy, so text without special characters costs one scan and one copy.
+*/
+#if defined(CCSTRING_SSE2)
+static __m128i ccstring_scan_hits(__m128i chunk, const __m128i* needles, size_t count, int controls)
+{
+    __m128i hits = _mm_cmpeq_epi8(chunk, needles[0]);
+    for (size_t k = 1; k < count; ++k) {
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, needles[k]));
+    }
+    if (controls) {
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(_mm_min_epu8(chunk, _mm_set1_epi8(0x1f)), chunk));
+    }
+    return hits;
+}
+#endif
+
+// Index of the first byte equal to one of count (1 to 4) needles, or of the first control character when
+// controls is set. Returns size if there is none.
+static size_t ccstring_scan_special(const unsigned char* in, size_t size, const unsigned char* needles, size_t count, int controls)
+{
+    size_t i = 0;
+
+#if defined(CCSTRING_SSE2)
+    __m128i splat[4];
+    for (size_t k = 0; k < count; ++k) {
+        splat[k] = _mm_set1_epi8((char)needles[k]);
+    }
+
+    // Clean text is skipped 64 bytes at a time; the 16-byte loop below locates the hit.
+    for (; i + 64 <= size; i += 64) {
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(ccstring_scan_hits(_mm_loadu_si128((const __m128i*)(in + i)), splat, count, controls),
+                ccstring_scan_hits(_mm_loadu_si128((const __m128i*)(in + i + 16)), splat, count, controls)),
+            _mm_or_si128(ccstring_scan_hits(_mm_loadu_si128((const __m128i*)(in + i + 32)), splat, count, controls),
+                ccstring_scan_hits(_mm_loadu_si128((const __m128i*)(in + i + 48)), splat, count, controls)));
+        if (_mm_movemask_epi8(hits) != 0) {
+            break;
+        }
+    }
+    for (; i + 16 <= size; i += 16) {
+        __m128i hits = ccstring_scan_hits(_mm_loadu_si128((const __m128i*)(in + i)), splat, count, controls);
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return i + ccstring_ctz32((uint32_t)mask);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (controls && in[i] < 0x20) {
+            return i;
+        }
+        for (size_t k = 0; k < count; ++k) {
+            if (in[i] == needles[k]) {
+                return i;
+            }
+        }
+    }
+    return size;
+}
+
+// The character after the backslash for escapes with a short form, or 0 for \u00XX.
+static char ccstring_json_short_escape(unsigned char c)
+{
+    switch (c) {
+    case '"': return '"';
+    case '\\': return '\\';
+    case '\b': return 'b';
+    case '\f': return 'f';
+    case '\n': return 'n';
+    case '\r': return 'r';
+    case '\t': return 't';
+    default: return 0;
+    }
+}
+
+static size_t ccstring_utf8_encode(uint32_t code_point, char* out)
+{
+    if (code_point < 0x80) {
+        out[0] = (char)code_point;
+        return 1;
+    }
+    if (code_point < 0x800) {
+        out[0] = (char)(0xc0 | (code_point >> 6));
+        out[1] = (char)(0x80 | (code_point & 0x3f));
+        return 2;
+    }
+    if (code_point < 0x10000) {
+        out[0] = (char)(0xe0 | (code_point >> 12));
+        out[1] = (char)(0x80 | ((code_point >> 6) & 0x3f));
+        out[2] = (char)(0x80 | (code_point & 0x3f));
+        return 3;
+    }
+    out[0] = (char)(0xf0 | (code_point >> 18));
+    out[1] = (char)(0x80 | ((code_point >> 12) & 0x3f));
+    out[2] = (char)(0x80 | ((code_point >> 6) & 0x3f));
+    out[3] = (char)(0x80 | (code_point & 0x3f));
+    return 4;
+}
+
+static int ccstring_json_hex4(const unsigned char* in, size_t size, uint32_t* out_value)
+{
+    uint32_t value = 0;
+
+    if (size < 4) {
+        return CCSTRING_FAILURE;
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        int digit = ccstring_hex_value(in[i]);
+        if (digit < 0) {
+            return CCSTRING_FAILURE;
+        }
+        value = (value << 4) | (uint32_t)digit;
+    }
+    *out_value = value;
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_append_json_escaped(ccstring_t** str, const ccstring_view_t* text)
+{
+    static const unsigned char needles[2] = { '"', '\\' };
+
+    if (!str || !*str || !text || (!text->buffer && text->length > 0) || text->length > SIZE_MAX / 6) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* in = (const unsigned char*)text->buffer;
+    size_t size = text->length;
+    size_t first = ccstring_scan_special(in, size, needles, 2, 1);
+
+    // Size the output exactly; clean text skips this pass entirely.
+    size_t out_size = size;
+    for (size_t i = first; i < size; i += 1 + ccstring_scan_special(in + i + 1, size - i - 1, needles, 2, 1)) {
+        out_size += ccstring_json_short_escape(in[i]) ? 1 : 5;
+    }
+
+    ccstring_t* target = *str;
+    if (ccstring_reserve_extra(target, out_size) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    char* out = target->buffer + target->length;
+    size_t i = 0;
+    size_t run = first;
+    for (;;) {
+        memcpy(out, in + i, run);
+        out += run;
+        i += run;
+        if (i == size) {
+            break;
+        }
+
+        char escape = ccstring_json_short_escape(in[i]);
+        *out++ = '\\';
+        if (escape) {
+            *out++ = escape;
+        } else {
+            *out++ = 'u';
+            *out++ = '0';
+            *out++ = '0';
+            *out++ = ccstring_hex_lower[in[i] >> 4];
+            *out++ = ccstring_hex_lower[in[i] & 0x0f];
+        }
+        ++i;
+        run = ccstring_scan_special(in + i, size - i, needles, 2, 1);
+    }
+
+    CCSTRING_STATS_ADD(bytes_copied, out_size);
+    ccstring_commit_extra(target, out_size);
+    return CCSTRING_SUCCESS;
+}
+
+// Writes the unescaped text to out, which must hold size bytes; escapes never expand.
+static int ccstring_json_unescape_into(const unsigned char* in, size_t size, char* out, size_t* out_size)
+{
+    static const unsigned char needles[2] = { '\\', '"' };
+    char* start = out;
+    size_t i = 0;
+
+    for (;;) {
+        size_t run = ccstring_scan_special(in + i, size - i, needles, 2, 1);
+        memcpy(out, in + i, run);
+        out += run;
+        i += run;
+        if (i == size) {
+            break;
+        }
+        // Raw quotes and control characters are not allowed inside a JSON string.
+        if (in[i] != '\\' || i + 1 == size) {
+            return CCSTRING_FAILURE;
+        }
+
+        unsigned char c = in[i + 1];
+        i += 2;
+        switch (c) {
+        case '"': *out++ = '"'; break;
+        case '\\': *out++ = '\\'; break;
+        case '/': *out++ = '/'; break;
+        case 'b': *out++ = '\b'; break;
+        case 'f': *out++ = '\f'; break;
+        case 'n': *out++ = '\n'; break;
+        case 'r': *out++ = '\r'; break;
+        case 't': *out++ = '\t'; break;
+        case 'u': {
+            uint32_t code_point;
+            if (ccstring_json_hex4(in + i, size - i, &code_point) != CCSTRING_SUCCESS) {
+                return CCSTRING_FAILURE;
+            }
+            i += 4;
+            if (code_point >= 0xd800 && code_point <= 0xdbff) {
+                uint32_t low;
+                if (size - i < 6 || in[i] != '\\' || in[i + 1] != 'u'
+                    || ccstring_json_hex4(in + i + 2, size - i - 2, &low) != CCSTRING_SUCCESS
+                    || low < 0xdc00 || low > 0xdfff) {
+                    return CCSTRING_FAILURE;
+                }
+                code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+                i += 6;
+            } else if (code_point >= 0xdc00 && code_point <= 0xdfff) {
+                return CCSTRING_FAILURE;
+            }
+            out += ccstring_utf8_encode(code_point, out);
+            break;
+        }
+        default:
+            return CCSTRING_FAILURE;
+        }
+    }
+
+    *out_size = (size_t)(out - start);
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_append_json_unescaped(ccstring_t** str, const ccstring_view_t* text)
+{
+    if (!str || !*str || !text || (!text->buffer && text->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_t* target = *str;
+    if (ccstring_reserve_extra(target, text->length) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    size_t out_size = 0;
+    if (ccstring_json_unescape_into((const unsigned char*)text->buffer, text->length,
+            target->buffer + target->length, &out_size) != CCSTRING_SUCCESS) {
+        target->buffer[target->length] = CCSTRING_NULL_TERMINATER;
+        return CCSTRING_FAILURE;
+    }
+
+    CCSTRING_STATS_ADD(bytes_copied, out_size);
+    ccstring_commit_extra(target, out_size);
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_append_csv_escaped(ccstring_t** str, const ccstring_view_t* field, char delimiter)
+{
+    static const unsigned char quote = '"';
+
+    if (!str || !*str || !field || (!field->buffer && field->length > 0) || field->length > SIZE_MAX / 2 - 1) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char needles[4] = { (unsigned char)delimiter, '"', '\r', '\n' };
+    const unsigned char* in = (const unsigned char*)field->buffer;
+    size_t size = field->length;
+    size_t first = ccstring_scan_special(in, size, needles, 4, 0);
+    ccstring_t* target = *str;
+
+    if (first == size) {
+        return ccstring_append(str, field->buffer, size);
+    }
+
+    size_t out_size = size + 2;
+    for (size_t i = first + ccstring_scan_special(in + first, size - first, &quote, 1, 0); i < size;
+         i += 1 + ccstring_scan_special(in + i + 1, size - i - 1, &quote, 1, 0)) {
+        ++out_size;
+    }
+
+    if (ccstring_reserve_extra(target, out_size) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    char* out = target->buffer + target->length;
+    size_t i = 0;
+    *out++ = '"';
+    for (;;) {
+        size_t run = ccstring_scan_special(in + i, size - i, &quote, 1, 0);
+        memcpy(out, in + i, run);
+        out += run;
+        i += run;
+        if (i == size) {
+            break;
+        }
+        *out++ = '"';
+        *out++ = '"';
+        ++i;
+    }
+    *out = '"';
+
+    CCSTRING_STATS_ADD(bytes_copied, out_size);
+    ccstring_commit_extra(target, out_size);
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_append_csv_unescaped(ccstring_t** str, const ccstring_view_t* field)
+{
+    static const unsigned char quote = '"';
+
+    if (!str || !*str || !field || (!field->buffer && field->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+    if (field->length == 0 || field->buffer[0] != '"') {
+        return ccstring_append(str, field->buffer, field->length);
+    }
+    if (field->length < 2 || field->buffer[field->length - 1] != '"') {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* in = (const unsigned char*)field->buffer + 1;
+    size_t size = field->length - 2;
+    ccstring_t* target = *str;
+    if (ccstring_reserve_extra(target, size) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    char* start = target->buffer + target->length;
+    char* out = start;
+    size_t i = 0;
+    for (;;) {
+        size_t run = ccstring_scan_special(in + i, size - i, &quote, 1, 0);
+        memcpy(out, in + i, run);
+        out += run;
+        i += run;
+        if (i == size) {
+            break;
+        }
+        // Inside a quoted field every quote must be doubled.
+        if (i + 1 == size || in[i + 1] != '"') {
+            target->buffer[target->length] = CCSTRING_NULL_TERMINATER;
+            return CCSTRING_FAILURE;
+        }
+        *out++ = '"';
+        i += 2;
+    }
+
+    CCSTRING_STATS_ADD(bytes_copied, (size_t)(out - start));
+    ccstring_commit_extra(target, (size_t)(out - start));
+    return CCSTRING_SUCCESS;
+}
+
+/**
+ * Glob matching: greedy scan that backtracks only to the most recent star, so it never recurses or allocates.
+*/
+// Matches byte against the bracket expression starting at pattern[0] == '['. Returns the length of the
+// expression, or 0 if it is not terminated (the '[' is then matched literally).
+static size_t ccstring_glob_class(const unsigned char* pattern, size_t length, unsigned char byte, int* out_matched)
+{
+    size_t i = 1;
+    int negate = 0;
+    int matched = 0;
+
+    if (i < length && (pattern[i] == '!' || pattern[i] == '^')) {
+        negate = 1;
+        ++i;
+    }
+    for (size_t start = i; i < length; ++i) {
+        unsigned char lo = pattern[i];
+        if (lo == ']' && i > start) {
+            *out_matched = matched != negate;
+            return i + 1;
+        }
+        if (lo == '\\' && i + 1 < length) {
+            lo = pattern[++i];
+        }
+        unsigned char hi = lo;
+        if (i + 2 < length && pattern[i + 1] == '-' && pattern[i + 2] != ']') {
+            i += 2;
+            hi = pattern[i];
+            if (hi == '\\' && i + 1 < length) {
+                hi = pattern[++i];
+            }
+        }
+        if (byte >= lo && byte <= hi) {
+            matched = 1;
+        }
+    }
+    return 0;
+}
+
+int ccstring_glob_match(const ccstring_view_t* pattern, const ccstring_view_t* text)
+{
+    if (!pattern || !text || (!pattern->buffer && pattern->length > 0) || (!text->buffer && text->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* pat = (const unsigned char*)pattern->buffer;
+    const unsigned char* str = (const unsigned char*)text->buffer;
+    size_t p = 0;
+    size_t t = 0;
+    size_t star_p = SIZE_MAX;
+    size_t star_t = 0;
+
+    while (t < text->length) {
+        if (p < pattern->length) {
+            unsigned char c = pat[p];
+            size_t advance = 0;
+            int matched = 0;
+
+            if (c == '*') {
+                star_p = ++p;
+                star_t = t;
+                continue;
+            }
+            if (c == '[') {
+                advance = ccstring_glob_class(pat + p, pattern->length - p, str[t], &matched);
+            }
+            if (advance == 0) {
+                advance = 1;
+                if (c == '?') {
+                    matched = 1;
+                } else {
+                    if (c == '\\' && p + 1 < pattern->length) {
+                        c = pat[p + 1];
+                        advance = 2;
+                    }
+                    matched = c == str[t];
+                }
+            }
+            if (matched) {
+                p += advance;
+                ++t;
+                continue;
+            }
+        }
+        // Mismatch: let the last star absorb one more byte, or fail if there is none.
+        if (star_p == SIZE_MAX) {
+            return CCSTRING_FAILURE;
+        }
+        p = star_p;
+        t = ++star_t;
+    }
+
+    while (p < pattern->length && pat[p] == '*') {
+        ++p;
+    }
+    return p == pattern->length ? CCSTRING_SUCCESS : CCSTRING_FAILURE;
+}
+
+/**
+ * Regular expressions: the pattern is compiled into a Glushkov automaton with one bit per literal or class
+ * position, so a set of active states fits in a uint64_t. Following every active position at once is a
+ * table lookup per state byte, which keeps matching linear in the text length without allocating.
+*/
+#define CCSTRING_REGEX_MAX_POSITIONS 64
+#define CCSTRING_REGEX_MAX_DEPTH 64
+#define CCSTRING_REGEX_MAX_PREFIX 16
+
+// Where an empty match is allowed, one flag per kind of alternative that can match nothing.
+#define CCSTRING_REGEX_EMPTY_ANYWHERE 1
+#define CCSTRING_REGEX_EMPTY_AT_START 2
+#define CCSTRING_REGEX_EMPTY_AT_END 4
+#define CCSTRING_REGEX_EMPTY_WHOLE 8
+
+// Anchors bind to their own top-level alternative: positions in first_start may only begin a match at the
+// start of the text, and positions in last_end may only end one at the end of the text.
+struct ccstring_regex {
+    uint64_t byte_mask[256];
+    uint64_t first;
+    uint64_t first_start;
+    uint64_t last;
+    uint64_t last_end;
+    unsigned int empty;
+    int anchored_start;
+    unsigned int blocks;
+    const uint64_t* forward;
+    const uint64_t* reverse;
+    size_t prefix_length;
+    unsigned char prefix[CCSTRING_REGEX_MAX_PREFIX];
+};
+
+typedef struct ccstring_regex_fragment {
+    uint64_t first;
+    uint64_t last;
+    int nullable;
+} ccstring_regex_fragment_t;
+
+typedef struct ccstring_regex_parser {
+    const unsigned char* pattern;
+    size_t length;
+    size_t pos;
+    unsigned int positions;
+    unsigned int depth;
+    uint64_t follow[CCSTRING_REGEX_MAX_POSITIONS];
+    uint64_t byte_mask[256];
+} ccstring_regex_parser_t;
+
+static int ccstring_regex_parse_alternation(ccstring_regex_parser_t* parser, ccstring_regex_fragment_t* out);
+
+static void ccstring_regex_set_add(uint64_t* set, unsigned int lo, unsigned int hi)
+{
+    for (unsigned int c = lo; c <= hi; ++c) {
+        set[c >> 6] |= (uint64_t)1 << (c & 63);
+    }
+}
+
+// Adds the members of a \d \w \s \D \W \S shorthand to set. Returns failure for any other byte.
+static int ccstring_regex_shorthand(unsigned char c, uint64_t* set)
+{
+    uint64_t members[4] = { 0, 0, 0, 0 };
+
+    switch (c | 0x20) {
+    case 'd':
+        ccstring_regex_set_add(members, '0', '9');
+        break;
+    case 'w':
+        ccstring_regex_set_add(members, '0', '9');
+        ccstring_regex_set_add(members, 'A', 'Z');
+        ccstring_regex_set_add(members, 'a', 'z');
+        ccstring_regex_set_add(members, '_', '_');
+        break;
+    case 's':
+        ccstring_regex_set_add(members, '\t', '\r');
+        ccstring_regex_set_add(members, ' ', ' ');
+        break;
+    default:
+        return CCSTRING_FAILURE;
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        set[i] |= (c >= 'a') ? members[i] : ~members[i];
+    }
+    return CCSTRING_SUCCESS;
+}
+
+// The byte an escape stands for, or -1 for escapes that are not single bytes.
+static int ccstring_regex_escape_byte(unsigned char c)
+{
+    switch (c) {
+    case 'n': return '\n';
+    case 'r': return '\r';
+    case 't': return '\t';
+    case 'f': return '\f';
+    case 'v': return '\v';
+    default:
+        if ((c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z')) {
+            return -1;
+        }
+        return c;
+    }
+}
+
+static int ccstring_regex_add_position(ccstring_regex_parser_t* parser, const uint64_t* set, ccstring_regex_fragment_t* out)
+{
+    if (parser->positions == CCSTRING_REGEX_MAX_POSITIONS) {
+        return CCSTRING_FAILURE;
+    }
+
+    uint64_t bit = (uint64_t)1 << parser->positions++;
+    for (unsigned int c = 0; c < 256; ++c) {
+        if (set[c >> 6] & ((uint64_t)1 << (c & 63))) {
+            parser->byte_mask[c] |= bit;
+        }
+    }
+    out->first = bit;
+    out->last = bit;
+    out->nullable = 0;
+    return CCSTRING_SUCCESS;
+}
+
+static void ccstring_regex_add_follow(ccstring_regex_parser_t* parser, uint64_t from, uint64_t to)
+{
+    while (from) {
+        parser->follow[ccstring_ctz64(from)] |= to;
+        from &= from - 1;
+    }
+}
+
+// Parses a bracket expression; parser->pos is just past the '['.
+static int ccstring_regex_parse_class(ccstring_regex_parser_t* parser, uint64_t* set)
+{
+    const unsigned char* pattern = parser->pattern;
+    size_t start;
+    int negate = 0;
+
+    if (parser->pos < parser->length && pattern[parser->pos] == '^') {
+        negate = 1;
+        parser->pos++;
+    }
+    start = parser->pos;
+
+    while (parser->pos < parser->length) {
+        unsigned char c = pattern[parser->pos];
+        int lo = c;
+
+        if (c == ']' && parser->pos > start) {
+            parser->pos++;
+            if (negate) {
+                for (size_t i = 0; i < 4; ++i) {
+                    set[i] = ~set[i];
+                }
+            }
+            return CCSTRING_SUCCESS;
+        }
+        if (c == '\\') {
+            if (parser->pos + 1 == parser->length) {
+                return CCSTRING_FAILURE;
+            }
+            unsigned char e = pattern[parser->pos + 1];
+            parser->pos += 2;
+            if (ccstring_regex_shorthand(e, set) == CCSTRING_SUCCESS) {
+                continue;
+            }
+            if ((lo = ccstring_regex_escape_byte(e)) < 0) {
+                return CCSTRING_FAILURE;
+            }
+        } else {
+            parser->pos++;
+        }
+
+        int hi = lo;
+        if (parser->pos + 1 < parser->length && pattern[parser->pos] == '-' && pattern[parser->pos + 1] != ']') {
+            hi = pattern[parser->pos + 1];
+            parser->pos += 2;
+            if (hi == '\\') {
+                if (parser->pos == parser->length || (hi = ccstring_regex_escape_byte(pattern[parser->pos])) < 0) {
+                    return CCSTRING_FAILURE;
+                }
+                parser->pos++;
+            }
+            if (hi < lo) {
+                return CCSTRING_FAILURE;
+            }
+        }
+        ccstring_regex_set_add(set, (unsigned int)lo, (unsigned int)hi);
+    }
+    return CCSTRING_FAILURE;
+}
+
+static int ccstring_regex_parse_atom(ccstring_regex_parser_t* parser, ccstring_regex_fragment_t* out)
+{
+    uint64_t set[4] = { 0, 0, 0, 0 };
+    unsigned char c = parser->pattern[parser->pos++];
+
+    switch (c) {
+    case '(':
+        if (++parser->depth > CCSTRING_REGEX_MAX_DEPTH
+            || ccstring_regex_parse_alternation(parser, out) != CCSTRING_SUCCESS
+            || parser->pos == parser->length || parser->pattern[parser->pos] != ')') {
+            return CCSTRING_FAILURE;
+        }
+        parser->pos++;
+        parser->depth--;
+        return CCSTRING_SUCCESS;
+    case '[':
+        if (ccstring_regex_parse_class(parser, set) != CCSTRING_SUCCESS) {
+            return CCSTRING_FAILURE;
+        }
+        break;
+    case '.':
+        ccstring_regex_set_add(set, 0, 255);
+        set[0] &= ~((uint64_t)1 << '\n');
+        break;
+    case '\\': {
+        if (parser->pos == parser->length) {
+            return CCSTRING_FAILURE;
+        }
+        unsigned char e = parser->pattern[parser->pos++];
+        if (ccstring_regex_shorthand(e, set) != CCSTRING_SUCCESS) {
+            int byte = ccstring_regex_escape_byte(e);
+            if (byte < 0) {
+                return CCSTRING_FAILURE;
+            }
+            ccstring_regex_set_add(set, (unsigned int)byte, (unsigned int)byte);
+        }
+        break;
+    }
+    // Quantifiers with nothing to repeat, counted repetition and anchors in the middle of a pattern.
+    case '*': case '+': case '?': case '{': case '}': case '^': case '$':
+        return CCSTRING_FAILURE;
+    default:
+        ccstring_regex_set_add(set, c, c);
+        break;
+    }
+    return ccstring_regex_add_position(parser, set, out);
+}
+
+static int ccstring_regex_parse_repeat(ccstring_regex_parser_t* parser, ccstring_regex_fragment_t* out)
+{
+    if (ccstring_regex_parse_atom(parser, out) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    while (parser->pos < parser->length) {
+        unsigned char c = parser->pattern[parser->pos];
+        if (c != '*' && c != '+' && c != '?') {
+            break;
+        }
+        if (c != '?') {
+            ccstring_regex_add_follow(parser, out->last, out->first);
+        }
+        if (c != '+') {
+            out->nullable = 1;
+        }
+        parser->pos++;
+    }
+    return CCSTRING_SUCCESS;
+}
+
+static int ccstring_regex_parse_concat(ccstring_regex_parser_t* parser, ccstring_regex_fragment_t* out)
+{
+    out->first = 0;
+    out->last = 0;
+    out->nullable = 1;
+
+    while (parser->pos < parser->length && parser->pattern[parser->pos] != '|' && parser->pattern[parser->pos] != ')'
+        && parser->pattern[parser->pos] != '$') {
+        ccstring_regex_fragment_t item;
+        if (ccstring_regex_parse_repeat(parser, &item) != CCSTRING_SUCCESS) {
+            return CCSTRING_FAILURE;
+        }
+        ccstring_regex_add_follow(parser, out->last, item.first);
+        out->first = out->nullable ? out->first | item.first : out->first;
+        out->last = item.nullable ? out->last | item.last : item.last;
+        out->nullable = out->nullable && item.nullable;
+    }
+    return CCSTRING_SUCCESS;
+}
+
+static int ccstring_regex_parse_alternation(ccstring_regex_parser_t* parser, ccstring_regex_fragment_t* out)
+{
+    if (ccstring_regex_parse_concat(parser, out) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    while (parser->pos < parser->length && parser->pattern[parser->pos] == '|') {
+        ccstring_regex_fragment_t branch;
+        parser->pos++;
+        if (ccstring_regex_parse_concat(parser, &branch) != CCSTRING_SUCCESS) {
+            return CCSTRING_FAILURE;
+        }
+        out->first |= branch.first;
+        out->last |= branch.last;
+        out->nullable = out->nullable || branch.nullable;
+    }
+    return CCSTRING_SUCCESS;
+}
+
+// Top level: alternatives separated by |, each of which may begin with ^ and end with $. As in PCRE and
+// POSIX an anchor applies to its own alternative only, so ^a|b finds a at the start or b anywhere.
+static int ccstring_regex_parse_top(ccstring_regex_parser_t* parser, ccstring_regex_t* regex)
+{
+    for (;;) {
+        ccstring_regex_fragment_t branch;
+        int at_start = 0;
+        int at_end = 0;
+
+        if (parser->pos < parser->length && parser->pattern[parser->pos] == '^') {
+            at_start = 1;
+            parser->pos++;
+        }
+        if (ccstring_regex_parse_concat(parser, &branch) != CCSTRING_SUCCESS) {
+            return CCSTRING_FAILURE;
+        }
+        if (parser->pos < parser->length && parser->pattern[parser->pos] == '$') {
+            at_end = 1;
+            parser->pos++;
+        }
+
+        if (at_start) {
+            regex->first_start |= branch.first;
+        } else {
+            regex->first |= branch.first;
+        }
+        if (at_end) {
+            regex->last_end |= branch.last;
+        } else {
+            regex->last |= branch.last;
+        }
+        if (branch.nullable) {
+            regex->empty |= at_start ? (at_end ? CCSTRING_REGEX_EMPTY_WHOLE : CCSTRING_REGEX_EMPTY_AT_START)
+                                     : (at_end ? CCSTRING_REGEX_EMPTY_AT_END : CCSTRING_REGEX_EMPTY_ANYWHERE);
+        }
+
+        if (parser->pos == parser->length) {
+            return CCSTRING_SUCCESS;
+        }
+        if (parser->pattern[parser->pos] != '|') {
+            return CCSTRING_FAILURE;
+        }
+        parser->pos++;
+    }
+}
+
+// The bytes every match starts with, found by walking positions that have a single successor and byte.
+static void ccstring_regex_find_prefix(ccstring_regex_t* regex, const uint64_t* follow)
+{
+    uint64_t set = regex->first | regex->first_start;
+    uint64_t visited = 0;
+
+    if (regex->empty) {
+        return;
+    }
+    while (regex->prefix_length < CCSTRING_REGEX_MAX_PREFIX && set != 0 && (set & (set - 1)) == 0 && !(visited & set)) {
+        int byte = -1;
+        for (unsigned int c = 0; c < 256; ++c) {
+            if (regex->byte_mask[c] & set) {
+                if (byte >= 0) {
+                    return;
+                }
+                byte = (int)c;
+            }
+        }
+        if (byte < 0) {
+            return;
+        }
+        regex->prefix[regex->prefix_length++] = (unsigned char)byte;
+        if ((regex->last | regex->last_end) & set) {
+            return;
+        }
+        visited |= set;
+        set = follow[ccstring_ctz64(set)];
+    }
+}
+
+// For each block of 8 positions and each pattern of active bits in it, the union of their successors.
+static void ccstring_regex_build_table(uint64_t* table, unsigned int blocks, const uint64_t* follow, unsigned int positions)
+{
+    for (unsigned int k = 0; k < blocks; ++k) {
+        for (unsigned int bits = 0; bits < 256; ++bits) {
+            uint64_t next = 0;
+            for (unsigned int j = 0; j < 8 && k * 8 + j < positions; ++j) {
+                if (bits & (1u << j)) {
+                    next |= follow[k * 8 + j];
+                }
+            }
+            table[k * 256 + bits] = next;
+        }
+    }
+}
+
+ccstring_regex_t* ccstring_regex_new(const ccstring_view_t* pattern)
+{
+    if (!pattern || (!pattern->buffer && pattern->length > 0)) {
+        return NULL;
+    }
+
+    ccstring_regex_parser_t parser;
+    ccstring_regex_t shape;
+
+    memset(&parser, 0, sizeof(parser));
+    memset(&shape, 0, sizeof(shape));
+    parser.pattern = (const unsigned char*)pattern->buffer;
+    parser.length = pattern->length;
+    if (ccstring_regex_parse_top(&parser, &shape) != CCSTRING_SUCCESS) {
+        return NULL;
+    }
+
+    unsigned int blocks = (parser.positions + 7) / 8;
+    ccstring_regex_t* regex = (ccstring_regex_t*)ccstring_calloc(1, sizeof(*regex) + 2 * (size_t)blocks * 256 * sizeof(uint64_t));
+    if (!regex) {
+        return NULL;
+    }
+
+    uint64_t reverse_follow[CCSTRING_REGEX_MAX_POSITIONS] = { 0 };
+    for (unsigned int p = 0; p < parser.positions; ++p) {
+        for (uint64_t next = parser.follow[p]; next; next &= next - 1) {
+            reverse_follow[ccstring_ctz64(next)] |= (uint64_t)1 << p;
+        }
+    }
+
+    uint64_t* tables = (uint64_t*)(regex + 1);
+    ccstring_regex_build_table(tables, blocks, parser.follow, parser.positions);
+    ccstring_regex_build_table(tables + (size_t)blocks * 256, blocks, reverse_follow, parser.positions);
+
+    memcpy(regex->byte_mask, parser.byte_mask, sizeof(regex->byte_mask));
+    regex->first = shape.first;
+    regex->first_start = shape.first_start;
+    regex->last = shape.last;
+    regex->last_end = shape.last_end;
+    regex->empty = shape.empty;
+    // Every match starts at 0 when no alternative can begin or match empty anywhere else.
+    regex->anchored_start = shape.first == 0 && !(shape.empty & (CCSTRING_REGEX_EMPTY_ANYWHERE | CCSTRING_REGEX_EMPTY_AT_END));
+    regex->blocks = blocks;
+    regex->forward = tables;
+    regex->reverse = tables + (size_t)blocks * 256;
+    ccstring_regex_find_prefix(regex, parser.follow);
+    return regex;
+}
+
+void ccstring_regex_destroy(ccstring_regex_t** regex)
+{
+    if (!regex || !*regex) return;
+
+    ccstring_free(*regex);
+    *regex = NULL;
+}
+
+static uint64_t ccstring_regex_step(const uint64_t* table, unsigned int blocks, uint64_t state)
+{
+    uint64_t next = 0;
+
+    // Text that keeps no state alive, the common case when scanning for rare matches, skips the lookups.
+    if (!state) {
+        return 0;
+    }
+    for (unsigned int k = 0; k < blocks; ++k) {
+        next |= table[k * 256 + ((state >> (8 * k)) & 0xff)];
+    }
+    return next;
+}
+
+// Position of the first occurrence of literal in text, or SIZE_MAX. Candidates are found by comparing
+// the first and last literal bytes 16 positions at a time.
+static size_t ccstring_find_literal(const unsigned char* text, size_t size, const unsigned char* literal, size_t length)
+{
+    size_t i = 0;
+
+    if (length > size) {
+        return SIZE_MAX;
+    }
+    size_t last_start = size - length;
+
+#if defined(CCSTRING_SSE2)
+    const __m128i first = _mm_set1_epi8((char)literal[0]);
+    const __m128i last = _mm_set1_epi8((char)literal[length - 1]);
+    for (; i + 16 <= last_start + 1; i += 16) {
+        __m128i head = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(text + i)), first);
+        __m128i tail = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(text + i + length - 1)), last);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(head, tail));
+        while (mask) {
+            size_t candidate = i + ccstring_ctz32(mask);
+            if (memcmp(text + candidate, literal, length) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i <= last_start; ++i) {
+        if (text[i] == literal[0] && memcmp(text + i, literal, length) == 0) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+// First position at or after from where a match can start, or SIZE_MAX.
+static size_t ccstring_regex_prefilter(const ccstring_regex_t* regex, const unsigned char* text, size_t size, size_t from)
+{
+    if (regex->prefix_length == 0) {
+        return from;
+    }
+    size_t found = ccstring_find_literal(text + from, size - from, regex->prefix, regex->prefix_length);
+    return found == SIZE_MAX ? SIZE_MAX : from + found;
+}
+
+// Whether an empty match is allowed at pos in a text of size bytes.
+static int ccstring_regex_empty_at(const ccstring_regex_t* regex, size_t pos, size_t size)
+{
+    unsigned int empty = regex->empty;
+    return (empty & CCSTRING_REGEX_EMPTY_ANYWHERE)
+        || ((empty & CCSTRING_REGEX_EMPTY_AT_START) && pos == 0)
+        || ((empty & CCSTRING_REGEX_EMPTY_AT_END) && pos == size)
+        || ((empty & CCSTRING_REGEX_EMPTY_WHOLE) && pos == 0 && size == 0);
+}
+
+// End of the longest match that starts exactly at start.
+static int ccstring_regex_longest(const ccstring_regex_t* regex, const unsigned char* text, size_t size, size_t start, size_t* out_end)
+{
+    int found = ccstring_regex_empty_at(regex, start, size);
+    size_t end = start;
+    uint64_t state = 0;
+
+    for (size_t i = start; i < size; ++i) {
+        uint64_t next = i == start ? regex->first | (start == 0 ? regex->first_start : 0)
+                                   : ccstring_regex_step(regex->forward, regex->blocks, state);
+        state = next & regex->byte_mask[text[i]];
+        if (!state) {
+            break;
+        }
+        if ((state & regex->last) || ((state & regex->last_end) && i + 1 == size)) {
+            found = 1;
+            end = i + 1;
+        }
+    }
+    if (!found) {
+        return CCSTRING_FAILURE;
+    }
+    *out_end = end;
+    return CCSTRING_SUCCESS;
+}
+
+// Start of the leftmost match at or after lower, found by running the reversed automaton from the end of the text.
+static int ccstring_regex_leftmost(const ccstring_regex_t* regex, const unsigned char* text, size_t size, size_t lower, size_t* out_start)
+{
+    // Nothing can start further left than an empty match at lower.
+    if (ccstring_regex_empty_at(regex, lower, size)) {
+        *out_start = lower;
+        return CCSTRING_SUCCESS;
+    }
+
+    int found = ccstring_regex_empty_at(regex, size, size);
+    size_t start = size;
+    uint64_t state = 0;
+
+    const uint64_t* byte_mask = regex->byte_mask;
+    const uint64_t first = regex->first;
+    const uint64_t first_start = regex->first_start;
+    const uint64_t inject = regex->last;
+    uint64_t inject_end = regex->last_end;
+    for (size_t i = size; i > lower; --i) {
+        state = (ccstring_regex_step(regex->reverse, regex->blocks, state) | inject | inject_end) & byte_mask[text[i - 1]];
+        inject_end = 0;
+        if (state & (i == 1 ? first | first_start : first)) {
+            found = 1;
+            start = i - 1;
+        }
+        if (!state && !inject) {
+            break;
+        }
+    }
+    if (!found) {
+        return CCSTRING_FAILURE;
+    }
+    *out_start = start;
+    return CCSTRING_SUCCESS;
+}
+
+// Whether any match exists, in one forward pass that jumps between prefix candidates while no state is active.
+static int ccstring_regex_exists(const ccstring_regex_t* regex, const unsigned char* text, size_t size)
+{
+    if (ccstring_regex_empty_at(regex, 0, size) || ccstring_regex_empty_at(regex, size, size)) {
+        return CCSTRING_SUCCESS;
+    }
+
+    size_t i = ccstring_regex_prefilter(regex, text, size, 0);
+    uint64_t state = 0;
+
+    if (i == SIZE_MAX) {
+        return CCSTRING_FAILURE;
+    }
+
+    for (; i < size; ++i) {
+        uint64_t inject = i == 0 ? regex->first | regex->first_start : regex->first;
+        state = (ccstring_regex_step(regex->forward, regex->blocks, state) | inject) & regex->byte_mask[text[i]];
+        if ((state & regex->last) || ((state & regex->last_end) && i + 1 == size)) {
+            return CCSTRING_SUCCESS;
+        }
+        if (!state && regex->prefix_length > 0) {
+            size_t next = ccstring_regex_prefilter(regex, text, size, i + 1);
+            if (next == SIZE_MAX) {
+                return CCSTRING_FAILURE;
+            }
+            i = next - 1;
+        }
+    }
+    return CCSTRING_FAILURE;
+}
+
+int ccstring_regex_match(const ccstring_regex_t* regex, const ccstring_view_t* text)
+{
+    size_t end;
+
+    if (!regex || !text || (!text->buffer && text->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+    if (ccstring_regex_longest(regex, (const unsigned char*)text->buffer, text->length, 0, &end) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+    return end == text->length ? CCSTRING_SUCCESS : CCSTRING_FAILURE;
+}
+
+int ccstring_regex_search(const ccstring_regex_t* regex, const ccstring_view_t* text, ccstring_slice_t* out_match)
+{
+    if (!regex || !text || (!text->buffer && text->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    const unsigned char* buffer = (const unsigned char*)text->buffer;
+    size_t size = text->length;
+    size_t start = 0;
+    size_t end;
+
+    if (regex->anchored_start) {
+        if (size < regex->prefix_length || memcmp(buffer, regex->prefix, regex->prefix_length) != 0) {
+            return CCSTRING_FAILURE;
+        }
+    } else if (!out_match) {
+        return ccstring_regex_exists(regex, buffer, size);
+    } else {
+        size_t lower = ccstring_regex_prefilter(regex, buffer, size, 0);
+        if (lower == SIZE_MAX || ccstring_regex_leftmost(regex, buffer, size, lower, &start) != CCSTRING_SUCCESS) {
+            return CCSTRING_FAILURE;
+        }
+    }
+
+    if (ccstring_regex_longest(regex, buffer, size, start, &end) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+    if (out_match) {
+        out_match->buffer = text->buffer + start;
+        out_match->length = end - start;
+    }
+    return CCSTRING_SUCCESS;
+}
+
+#define CCSTRING_MYERS_MAX 64
+#define CCSTRING_MYERS_SPARSE_CLEAR 64
+#define CCSTRING_LEVENSHTEIN_MIN_BAND 32
+#define CCSTRING_LEVENSHTEIN_STACK_ROW 256
+#define CCSTRING_FUZZY_PARALLEL_THRESHOLD 4096
+#define CCSTRING_FUZZY_MIN_CHUNK 1024
+
+// Builds the match vector of every byte of pattern. For short pairs only the entries that the scan of text
+// will read are cleared, which beats clearing all 256. Pass a NULL text to clear the whole table.
+static void ccstring_myers_prepare(uint64_t* peq, const unsigned char* pattern, size_t length, const unsigned char* text, size_t size)
+{
+    if (text && length + size <= CCSTRING_MYERS_SPARSE_CLEAR) {
+        for (size_t j = 0; j < size; ++j) {
+            peq[text[j]] = 0;
+        }
+        for (size_t i = 0; i < length; ++i) {
+            peq[pattern[i]] = 0;
+        }
+    } else {
+        memset(peq, 0, 256 * sizeof(*peq));
+    }
+    for (size_t i = 0; i < length; ++i) {
+        peq[pattern[i]] |= (uint64_t)1 << i;
+    }
+}
+
+// Hyyro's formulation of Myers' bit-vector algorithm: one column of the DP matrix per text byte, with the
+// vertical deltas of the whole column packed into pv/mv. length is 1..64. Returns bound + 1 once the score
+// minus the remaining text can no longer get back under bound.
+static size_t ccstring_myers(const uint64_t* peq, size_t length, const unsigned char* text, size_t size, size_t bound)
+{
+    uint64_t pv = ~(uint64_t)0;
+    uint64_t mv = 0;
+    uint64_t top = (uint64_t)1 << (length - 1);
+    size_t score = length;
+
+    for (size_t j = 0; j < size; ++j) {
+        uint64_t eq = peq[text[j]];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+
+        score += (ph & top) != 0;
+        score -= (mh & top) != 0;
+        if (score > bound + (size - j - 1)) {
+            return bound + 1;
+        }
+
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
+}
+
+// Ukkonen's banded DP, m <= n and n - m <= band. A path that strays to diagonal j - i = d pays at least
+// |d| + |n - m - d| indels, so only the diagonals from -slack to n - m + slack can stay within band.
+// Cells outside count as band + 1, and a row whose minimum exceeds band ends the scan.
+static int ccstring_levenshtein_banded(const unsigned char* a, size_t m, const unsigned char* b, size_t n, size_t band, size_t* out_distance)
+{
+    size_t stack_row[CCSTRING_LEVENSHTEIN_STACK_ROW];
+    size_t* row = stack_row;
+    size_t limit = band + 1;
+    size_t slack = (band - (n - m)) / 2;
+    size_t upper = n - m + slack;
+    size_t result = limit;
+
+    if (n + 1 > CCSTRING_LEVENSHTEIN_STACK_ROW) {
+        row = (size_t*)ccstring_malloc((n + 1) * sizeof(*row));
+        if (!row) {
+            return CCSTRING_FAILURE;
+        }
+    }
+
+    for (size_t j = 0; j <= n; ++j) {
+        row[j] = j <= upper ? j : limit;
+    }
+
+    size_t i;
+    for (i = 1; i <= m; ++i) {
+        size_t lo = i > slack ? i - slack : 1;
+        size_t hi = i + upper < n ? i + upper : n;
+        size_t diag = row[lo - 1];
+        size_t left = i <= slack ? i : limit;
+        size_t row_min = left;
+        unsigned char c = a[i - 1];
+
+        row[lo - 1] = left;
+        for (size_t j = lo; j <= hi; ++j) {
+            size_t up = row[j];
+            size_t cell = diag + (c != b[j - 1]);
+            if (up + 1 < cell) {
+                cell = up + 1;
+            }
+            if (left + 1 < cell) {
+                cell = left + 1;
+            }
+            if (cell > limit) {
+                cell = limit;
+            }
+            diag = up;
+            row[j] = cell;
+            left = cell;
+            if (cell < row_min) {
+                row_min = cell;
+            }
+        }
+        if (row_min > band) {
+            break;
+        }
+    }
+
+    if (i > m) {
+        result = row[n];
+    }
+    if (row != stack_row) {
+        ccstring_free(row);
+    }
+    *out_distance = result;
+    return CCSTRING_SUCCESS;
+}
+
+// Distance between a and b, or bound + 1 once it is known to be larger. bound must not exceed max(m, n).
+static int ccstring_levenshtein_core(const unsigned char* a, size_t m, const unsigned char* b, size_t n, size_t bound, size_t* out_distance)
+{
+    while (m > 0 && n > 0 && *a == *b) {
+        ++a;
+        ++b;
+        --m;
+        --n;
+    }
+    while (m > 0 && n > 0 && a[m - 1] == b[n - 1]) {
+        --m;
+        --n;
+    }
+    if (m > n) {
+        const unsigned char* text = a;
+        size_t size = m;
+        a = b;
+        m = n;
+        b = text;
+        n = size;
+    }
+
+    if (n - m > bound) {
+        *out_distance = bound + 1;
+        return CCSTRING_SUCCESS;
+    }
+    if (m == 0) {
+        *out_distance = n;
+        return CCSTRING_SUCCESS;
+    }
+    if (m <= CCSTRING_MYERS_MAX) {
+        uint64_t peq[256];
+        ccstring_myers_prepare(peq, a, m, b, n);
+        *out_distance = ccstring_myers(peq, m, b, n, bound);
+        return CCSTRING_SUCCESS;
+    }
+
+    // Start narrow and double the band; the work of all attempts stays within twice the final one.
+    size_t band = n - m > CCSTRING_LEVENSHTEIN_MIN_BAND ? n - m : CCSTRING_LEVENSHTEIN_MIN_BAND;
+    for (;;) {
+        size_t distance;
+        if (band > bound) {
+            band = bound;
+        }
+        if (ccstring_levenshtein_banded(a, m, b, n, band, &distance) != CCSTRING_SUCCESS) {
+            return CCSTRING_FAILURE;
+        }
+        if (distance <= band || band == bound) {
+            *out_distance = distance;
+            return CCSTRING_SUCCESS;
+        }
+        band *= 2;
+    }
+}
+
+int ccstring_levenshtein_bounded(const ccstring_view_t* a, const ccstring_view_t* b, size_t max_distance, size_t* out_distance)
+{
+    if (!a || !b || !out_distance || (!a->buffer && a->length > 0) || (!b->buffer && b->length > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    size_t longest = a->length > b->length ? a->length : b->length;
+    size_t bound = max_distance < longest ? max_distance : longest;
+    size_t distance;
+    if (ccstring_levenshtein_core((const unsigned char*)a->buffer, a->length, (const unsigned char*)b->buffer, b->length, bound, &distance) != CCSTRING_SUCCESS) {
+        return CCSTRING_FAILURE;
+    }
+
+    *out_distance = distance;
+    return CCSTRING_SUCCESS;
+}
+
+int ccstring_levenshtein(const ccstring_view_t* a, const ccstring_view_t* b, size_t* out_distance)
+{
+    return ccstring_levenshtein_bounded(a, b, SIZE_MAX, out_distance);
+}
+
+typedef struct ccstring_fuzzy_task {
+    const ccstring_manager_t* mgr;
+    const unsigned char* query;
+    size_t query_length;
+    const uint64_t* peq;
+    size_t begin;
+    size_t end;
+    size_t bound;
+    ccstring_fuzzy_match_t* matches;
+    size_t k;
+    size_t count;
+    int status;
+} ccstring_fuzzy_task_t;
+
+static CCSTRING_THREAD_RETURN ccstring_fuzzy_worker(void* arg)
+{
+    ccstring_fuzzy_task_t* task = (ccstring_fuzzy_task_t*)arg;
+    size_t bound = task->bound;
+
+    for (size_t i = task->begin; i < task->end; ++i) {
+        const ccstring_t* str = task->mgr->list[i];
+        if (!str) {
+            continue;
+        }
+
+        const unsigned char* text = (const unsigned char*)str->buffer;
+        size_t size = str->length;
+        size_t gap = size > task->query_length ? size - task->query_length : task->query_length - size;
+        if (gap > bound) {
+            continue;
+        }
+
+        size_t longest = size > task->query_length ? size : task->query_length;
+        size_t limit = bound < longest ? bound : longest;
+        size_t distance;
+        if (task->peq) {
+            // The query is short enough to keep its match vectors for the whole scan.
+            distance = ccstring_myers(task->peq, task->query_length, text, size, limit);
+        } else if (ccstring_levenshtein_core(task->query, task->query_length, text, size, limit, &distance) != CCSTRING_SUCCESS) {
+            task->status = CCSTRING_FAILURE;
+            break;
+        }
+        if (distance > bound) {
+            continue;
+        }
+
+        // Indices only grow, so an equal distance never displaces an earlier match.
+        size_t slot = task->count < task->k ? task->count++ : task->k - 1;
+        while (slot > 0 && task->matches[slot - 1].distance > distance) {
+            task->matches[slot] = task->matches[slot - 1];
+            --slot;
+        }
+        task->matches[slot].index = i;
+        task->matches[slot].distance = distance;
+
+        if (task->count == task->k) {
+            if (task->matches[task->k - 1].distance == 0) {
+                break;
+            }
+            bound = task->matches[task->k - 1].distance - 1;
+        }
+    }
+    return CCSTRING_THREAD_RESULT;
+}
+
+int ccstring_manager_nearest(const ccstring_manager_t* mgr, const ccstring_view_t* query, size_t max_distance, ccstring_fuzzy_match_t* out_matches, size_t k, size_t* out_count)
+{
+    if (!mgr || !query || !out_count || (!query->buffer && query->length > 0) || (!out_matches && k > 0)) {
+        return CCSTRING_FAILURE;
+    }
+
+    *out_count = 0;
+    if (k == 0 || !mgr->list || mgr->count == 0) {
+        return CCSTRING_SUCCESS;
+    }
+    if (k > mgr->count) {
+        k = mgr->count;
+    }
+
+    size_t thread_count = 1;
+    if (mgr->count >= CCSTRING_FUZZY_PARALLEL_THRESHOLD) {
+        thread_count = ccstring_thread_count();
+        if (thread_count > mgr->count / CCSTRING_FUZZY_MIN_CHUNK) {
+            thread_count = mgr->count / CCSTRING_FUZZY_MIN_CHUNK;
+        }
+    }
+    if (k > SIZE_MAX / sizeof(ccstring_fuzzy_match_t) / thread_count) {
+        return CCSTRING_FAILURE;
+    }
+
+    ccstring_fuzzy_task_t* tasks = (ccstring_fuzzy_task_t*)ccstring_calloc(thread_count, sizeof(*tasks));
+    ccstring_fuzzy_match_t* matches = (ccstring_fuzzy_match_t*)ccstring_malloc(thread_count * k * sizeof(*matches));
+    ccstring_thread_t* threads = (ccstring_thread_t*)ccstring_malloc(thread_count * sizeof(*threads));
+    int* started = (int*)ccstring_calloc(thread_count, sizeof(*started));
+    if (!tasks || !matches || !threads || !started) {
+        ccstring_free(tasks);
+        ccstring_free(matches);
+        ccstring_free(threads);
+        ccstring_free(started);
+        return CCSTRING_FAILURE;
+    }
+
+    uint64_t peq[256];
+    const unsigned char* text = (const unsigned char*)query->buffer;
+    int short_query = query->length > 0 && query->length <= CCSTRING_MYERS_MAX;
+    if (short_query) {
+        ccstring_myers_prepare(peq, text, query->length, NULL, 0);
+    }
+
+    size_t chunk = mgr->count / thread_count;
+    for (size_t t = 0; t < thread_count; ++t) {
+        tasks[t].mgr = mgr;
+        tasks[t].query = text;
+        tasks[t].query_length = query->length;
+        tasks[t].peq = short_query ? peq : NULL;
+        tasks[t].begin = t * chunk;
+        tasks[t].end = t + 1 == thread_count ? mgr->count : (t + 1) * chunk;
+        tasks[t].bound = max_distance;
+        tasks[t].matches = matches + t * k;
+        tasks[t].k = k;
+        tasks[t].status = CCSTRING_SUCCESS;
+    }
+
+    for (size_t t = 1; t < thread_count; ++t) {
+        started[t] = ccstring_thread_start(&threads[t], ccstring_fuzzy_worker, &tasks[t]) == CCSTRING_SUCCESS;
+    }
+
+    ccstring_fuzzy_worker(&tasks[0]);
+
+    int status = tasks[0].status;
+    for (size_t t = 1; t < thread_count; ++t) {
+        if (started[t]) {
+            ccstring_thread_join(threads[t]);
+        } else {
+            ccstring_fuzzy_worker(&tasks[t]);
+        }
+        if (tasks[t].status != CCSTRING_SUCCESS) {
+            status = CCSTRING_FAILURE;
+        }
+    }
+
+    // Every task list is sorted by distance then index, and the tasks cover increasing index ranges,
+    // so taking the smallest head (first task on ties) yields the global order.
+    if (status == CCSTRING_SUCCESS) {
+        size_t heads[CCSTRING_MAX_THREADS] = {0};
+        size_t written = 0;
+        while (written < k) {
+            size_t best = thread_count;
+            for (size_t t = 0; t < thread_count; ++t) {
+                if (heads[t] < tasks[t].count && (best == thread_count || tasks[t].matches[heads[t]].distance < tasks[best].matches[heads[best]].distance)) {
+                    best = t;
+                }
+            }
+            if (best == thread_count) {
+                break;
+            }
+            out_matches[written++] = tasks[best].matches[heads[best]++];
+        }
+        *out_count = written;
+    }
+
+    ccstring_free(tasks);
+    ccstring_free(matches);
+    ccstring_free(threads);
+    ccstring_free(started);
+    return status;
+}
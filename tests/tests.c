@@ -262,6 +262,655 @@ static void example_manager_safe_use(void)
     ccstring_manager_destroy(&manager);
 }
 
+static int example_byte_order(const char* a, size_t la, const char* b, size_t lb)
+{
+    int cmp = memcmp(a, b, la < lb ? la : lb);
+    if (cmp != 0) {
+        return cmp;
+    }
+    return (la > lb) - (la < lb);
+}
+
+static void example_sort_ccstrings(void)
+{
+    printf("------------------------------------------------------\n");
+    ccstring_manager_t manager = ccstring_manager_new(8);
+    const char* words[] = { "pear", "apple", "applesauce", "", "banana", "apple", "app", "cherry" };
+    const size_t word_count = sizeof(words) / sizeof(words[0]);
+
+    int rc;
+
+    for (size_t i = 0; i < word_count; i++) {
+        ccstring_t* added = ccstring_new_add_ref(&manager, words[i], strlen(words[i]));
+        assert(added != NULL);
+        (void)added;
+    }
+
+    rc = ccstring_manager_sort(&manager, CCSTRING_SORT_DEFAULT);
+    assert(rc == 0);
+    for (size_t i = 0; i < manager.count; i++) {
+        printf("Sorted string %zu: '%s'\n", i, ccstring_get(manager.list[i]));
+    }
+    assert(ccstring_length(manager.list[0]) == 0);
+    assert(strcmp(ccstring_get(manager.list[1]), "app") == 0);
+    assert(strcmp(ccstring_get(manager.list[4]), "applesauce") == 0);
+    assert(strcmp(ccstring_get(manager.list[7]), "pear") == 0);
+
+    // Stable sort keeps equal views in their original order.
+    const char* text = "b a b a";
+    ccstring_view_t views[4] = {
+        { text, 1 }, { text + 2, 1 }, { text + 4, 1 }, { text + 6, 1 }
+    };
+    rc = ccstring_view_sort(views, 4, CCSTRING_SORT_STABLE);
+    assert(rc == 0);
+    assert(views[0].buffer == text + 2 && views[1].buffer == text + 6);
+    assert(views[2].buffer == text && views[3].buffer == text + 4);
+
+    // Large inputs take the parallel path, which buckets past a prefix longer than one cached chunk.
+    const size_t large_count = 100000;
+    char* storage = (char*)malloc(large_count * 24);
+    ccstring_view_t* large = (ccstring_view_t*)malloc(large_count * sizeof(*large));
+    assert(storage != NULL && large != NULL);
+
+    unsigned int seed = 12345;
+    for (size_t i = 0; i < large_count; i++) {
+        char* entry = storage + i * 24;
+        seed = seed * 1103515245u + 12345u;
+        size_t length = 16 + (seed >> 16) % 8;
+        memcpy(entry, "https://host/", 13);
+        for (size_t j = 13; j < length; j++) {
+            seed = seed * 1103515245u + 12345u;
+            entry[j] = (char)('a' + (seed >> 16) % 4);
+        }
+        large[i].buffer = entry;
+        large[i].length = length;
+    }
+
+    rc = ccstring_view_sort(large, large_count, CCSTRING_SORT_PARALLEL | CCSTRING_SORT_STABLE);
+    assert(rc == 0);
+    size_t out_of_order = 0;
+    for (size_t i = 1; i < large_count; i++) {
+        int cmp = example_byte_order(large[i - 1].buffer, large[i - 1].length, large[i].buffer, large[i].length);
+        out_of_order += cmp > 0 || (cmp == 0 && large[i - 1].buffer > large[i].buffer);
+    }
+    assert(out_of_order == 0);
+    (void)out_of_order;
+    printf("Sorted %zu views, first: %.*s\n", large_count, (int)large[0].length, large[0].buffer);
+
+    // Reverse-sorted, already sorted and organ-pipe inputs must not degrade the recursion.
+    for (size_t i = 0; i < large_count; i++) {
+        char* entry = storage + i * 24;
+        size_t rank = i < large_count / 2 ? i : large_count - 1 - i;
+        large[i].length = (size_t)snprintf(entry, 24, "key-%016zu", large_count - rank);
+        large[i].buffer = entry;
+    }
+    for (int pass = 0; pass < 2; pass++) {
+        rc = ccstring_view_sort(large, large_count, CCSTRING_SORT_STABLE);
+        assert(rc == 0);
+        out_of_order = 0;
+        for (size_t i = 1; i < large_count; i++) {
+            int cmp = example_byte_order(large[i - 1].buffer, large[i - 1].length, large[i].buffer, large[i].length);
+            out_of_order += cmp > 0 || (cmp == 0 && large[i - 1].buffer > large[i].buffer);
+        }
+        assert(out_of_order == 0);
+    }
+    printf("Sorted %zu organ-pipe views, last: %.*s\n", large_count, (int)large[large_count - 1].length, large[large_count - 1].buffer);
+
+    free(large);
+    free(storage);
+    ccstring_manager_destroy(&manager);
+    (void)rc;
+}
+
+static void example_string_table(void)
+{
+    printf("------------------------------------------------------\n");
+    ccstring_manager_t manager = ccstring_manager_new(3);
+    ccstring_new_add_ref(&manager, "alpha", 5);
+    ccstring_new_add_ref(&manager, "", 0);
+    ccstring_new_add_ref(&manager, "gamma", 5);
+    assert(manager.count == 3);
+
+    ccstring_table_t table = ccstring_table_new(2, 8);
+    assert(table.data != NULL && table.offsets != NULL);
+
+    int rc = ccstring_table_append_manager(&table, &manager);
+    assert(rc == 0);
+    for (size_t i = 0; i < 100; i++) {
+        char entry[16];
+        int length = snprintf(entry, sizeof(entry), "entry-%zu", i);
+        rc = ccstring_table_append(&table, entry, (size_t)length);
+        assert(rc == 0);
+    }
+    ccstring_manager_destroy(&manager);
+
+    rc = ccstring_table_freeze(&table);
+    assert(rc == 0);
+    rc = ccstring_table_append(&table, "late", 4);
+    assert(rc != 0);
+    assert(table.count == 103);
+    (void)rc;
+
+    ccstring_view_t first = ccstring_table_get(&table, 0);
+    ccstring_view_t empty = ccstring_table_get(&table, 1);
+    ccstring_view_t last = ccstring_table_get(&table, 102);
+    ccstring_view_t missing = ccstring_table_get(&table, 103);
+    (void)first;
+    (void)empty;
+    (void)missing;
+
+    assert(first.length == 5 && memcmp(first.buffer, "alpha", 5) == 0);
+    assert(empty.length == 0 && empty.buffer[0] == '\0');
+    assert(last.length == 8 && strcmp(last.buffer, "entry-99") == 0);
+    assert(missing.buffer == NULL && missing.length == 0);
+
+    printf("Table entries: %zu, data bytes: %zu, last: %s\n", table.count, table.data_length, last.buffer);
+    ccstring_table_destroy(&table);
+    assert(table.data == NULL && table.count == 0);
+}
+
+static void example_string_table_file(void)
+{
+    printf("------------------------------------------------------\n");
+    const char* path = "ccstring_tests_table.bin";
+    ccstring_manager_t manager = ccstring_manager_new(4);
+    ccstring_new_add_ref(&manager, "red", 3);
+    ccstring_new_add_ref(&manager, "green", 5);
+    ccstring_new_add_ref(&manager, "", 0);
+    ccstring_new_add_ref(&manager, "blue", 4);
+    assert(manager.count == 4);
+
+    int rc = ccstring_manager_write(&manager, path, CCSTRING_TABLE_HASH_INDEX);
+    assert(rc == 0);
+    ccstring_manager_destroy(&manager);
+
+    ccstring_table_t table = {0};
+    rc = ccstring_table_map(&table, path);
+    assert(rc == 0);
+    assert(table.count == 4 && table.frozen && table.hash_index != NULL);
+
+    ccstring_view_t green = ccstring_table_get(&table, 1);
+    assert(green.length == 5 && strcmp(green.buffer, "green") == 0);
+
+    size_t index = 0;
+    rc = ccstring_table_find(&table, "blue", 4, &index);
+    assert(rc == 0 && index == 3);
+    rc = ccstring_table_find(&table, "", 0, &index);
+    assert(rc == 0 && index == 2);
+    rc = ccstring_table_find(&table, "purple", 6, &index);
+    assert(rc != 0);
+    printf("Mapped table entries: %zu, entry 1: %s\n", table.count, green.buffer);
+    ccstring_table_destroy(&table);
+
+    // Files without a hash index fall back to a linear scan.
+    ccstring_table_t built = ccstring_table_new(0, 0);
+    rc = ccstring_table_append(&built, "only", 4);
+    assert(rc == 0);
+    rc = ccstring_table_write(&built, path, CCSTRING_TABLE_DEFAULT);
+    assert(rc == 0);
+    ccstring_table_destroy(&built);
+
+    rc = ccstring_table_map(&table, path);
+    assert(rc == 0);
+    assert(table.hash_index == NULL);
+    rc = ccstring_table_find(&table, "only", 4, &index);
+    assert(rc == 0 && index == 0);
+    ccstring_table_destroy(&table);
+
+    // Anything that is not a table file is rejected.
+    FILE* file = fopen(path, "wb");
+    assert(file != NULL);
+    fputs("not a table", file);
+    fclose(file);
+    rc = ccstring_table_map(&table, path);
+    assert(rc != 0);
+
+    remove(path);
+    (void)rc;
+}
+
+static int example_radix_collect(const ccstring_view_t* key, void* value, void* context)
+{
+    size_t* visited = (size_t*)context;
+    printf("Prefix match %zu: %.*s -> %s\n", *visited, (int)key->length, key->buffer, (const char*)value);
+    (*visited)++;
+    return 0;
+}
+
+static void example_radix_tree(void)
+{
+    printf("------------------------------------------------------\n");
+    ccstring_manager_t manager = ccstring_manager_new(4);
+    ccstring_radix_t tree = ccstring_radix_new(&manager);
+    const char* routes[] = { "/api", "/api/users", "/api/users/admin", "/static", "/" };
+    const char* handlers[] = { "api", "users", "admin", "static", "root" };
+    int rc;
+
+    for (size_t i = 0; i < 5; i++) {
+        ccstring_view_t key = { routes[i], strlen(routes[i]) };
+        rc = ccstring_radix_insert(&tree, &key, (void*)handlers[i]);
+        assert(rc == 0);
+    }
+    assert(tree.count == 5 && manager.count == 5);
+
+    // Enough distinct first bytes to grow the root node past 48 children.
+    char keys[64][2];
+    for (size_t i = 0; i < 64; i++) {
+        keys[i][0] = (char)('0' + i);
+        keys[i][1] = 'x';
+        ccstring_view_t key = { keys[i], 2 };
+        rc = ccstring_radix_insert(&tree, &key, NULL);
+        assert(rc == 0);
+    }
+    assert(tree.count == 69);
+
+    void* value = NULL;
+    ccstring_view_t exact = { "/api/users", 10 };
+    rc = ccstring_radix_find(&tree, &exact, &value);
+    assert(rc == 0 && strcmp((const char*)value, "users") == 0);
+
+    ccstring_view_t missing = { "/api/user", 9 };
+    rc = ccstring_radix_find(&tree, &missing, &value);
+    assert(rc != 0);
+
+    ccstring_view_t request = { "/api/users/42", 13 };
+    ccstring_view_t matched = { "", 0 };
+    rc = ccstring_radix_longest_prefix(&tree, &request, &matched, &value);
+    assert(rc == 0);
+    assert(matched.length == 10 && strcmp((const char*)value, "users") == 0);
+    printf("Longest prefix of /api/users/42: %.*s\n", (int)matched.length, matched.buffer);
+
+    size_t visited = 0;
+    ccstring_view_t prefix = { "/api/", 5 };
+    rc = ccstring_radix_iterate_prefix(&tree, &prefix, example_radix_collect, &visited);
+    assert(rc == 0 && visited == 2);
+
+    // Replacing a value keeps the key count unchanged.
+    ccstring_view_t root = { "/", 1 };
+    rc = ccstring_radix_insert(&tree, &root, (void*)"index");
+    assert(rc == 0);
+    rc = ccstring_radix_find(&tree, &root, &value);
+    assert(rc == 0 && tree.count == 69);
+    assert(strcmp((const char*)value, "index") == 0);
+
+    ccstring_radix_destroy(&tree);
+    ccstring_manager_destroy(&manager);
+    (void)rc;
+}
+
+static void example_stats(void)
+{
+    printf("------------------------------------------------------\n");
+    ccstring_stats_t stats;
+    ccstring_stats_reset();
+
+    ccstring_t* str = ccstring_new("Hello", 5);
+    assert(str != NULL);
+    assert(ccstring_append(&str, ", World!", 8) == 0);
+    ccstring_destroy(&str);
+
+    ccstring_manager_t manager = ccstring_manager_new(1);
+    assert(ccstring_new_add_ref(&manager, "a", 1) != NULL);
+    assert(ccstring_new_add_ref(&manager, "b", 1) != NULL);
+    ccstring_manager_destroy(&manager);
+
+    if (ccstring_stats_snapshot(&stats) == 0) {
+        assert(stats.allocations >= 7);
+        assert(stats.reallocations >= 2);
+        assert(stats.frees == stats.allocations);
+        assert(stats.bytes_copied == 15);
+        assert(stats.strings_destroyed == 3);
+        assert(stats.length_histogram[1] == 2);
+        assert(stats.length_histogram[4] == 1);
+        assert(stats.manager_growths == 1);
+        assert(stats.manager_peak_count == 2);
+    } else {
+        assert(stats.allocations == 0 && stats.strings_destroyed == 0);
+    }
+
+    ccstring_stats_dump(stdout);
+}
+
+static const ccstring_t example_static_literal = CCSTRING_LITERAL_INIT("static literal");
+
+static void example_literal_and_stack_strings(void)
+{
+    printf("------------------------------------------------------\n");
+    assert(ccstring_length(&example_static_literal) == 14);
+    assert(strcmp(ccstring_get(&example_static_literal), "static literal") == 0);
+    printf("Static literal: %s\n", ccstring_get(&example_static_literal));
+
+    ccstring_t* literal = CCSTRING_LITERAL("Hello");
+    assert(ccstring_length(literal) == 5);
+    int rc = ccstring_append(&literal, "!", 1);
+    assert(rc != 0);
+    rc = ccstring_copy(&literal, "Bye", 3);
+    assert(rc != 0);
+    assert(ccstring_compare(literal, CCSTRING_LITERAL("Hello")) == 0);
+    printf("Literal: %s, Length: %zu\n", ccstring_get(literal), ccstring_length(literal));
+    ccstring_destroy(&literal);
+    assert(literal == NULL);
+
+    CCSTRING_STACK(scratch, 16);
+    rc = ccstring_append(&scratch, "Hello, World!", 13);
+    assert(rc == 0);
+    rc = ccstring_append(&scratch, "!!", 2);
+    assert(rc == 0);
+    assert(ccstring_get(scratch) == scratch_storage);
+    assert(strcmp(ccstring_get(scratch), "Hello, World!!!") == 0);
+
+    // The next append no longer fits the 16 byte buffer and spills to the heap.
+    rc = ccstring_append(&scratch, " Spilled.", 9);
+    assert(rc == 0);
+    assert(ccstring_get(scratch) != scratch_storage);
+    assert(strcmp(ccstring_get(scratch), "Hello, World!!! Spilled.") == 0);
+    printf("Stack string: %s, Length: %zu\n", ccstring_get(scratch), ccstring_length(scratch));
+    ccstring_destroy(&scratch);
+    assert(scratch == NULL);
+    (void)rc;
+}
+
+static void example_split_view(void)
+{
+    printf("------------------------------------------------------\n");
+    ccstring_view_t text = { "key=value;;last", 15 };
+    ccstring_split_t split = ccstring_split_new(&text, ";", 1);
+    ccstring_slice_t token;
+    size_t count = 0;
+
+    while (ccstring_split_next(&split, &token) == 0) {
+        printf("Token %zu: '%.*s'\n", count, (int)token.length, token.buffer);
+        count++;
+    }
+    assert(count == 3);
+    assert(token.length == 4 && memcmp(token.buffer, "last", 4) == 0);
+    assert(ccstring_split_next(&split, &token) != 0);
+}
+
+static void example_hex_and_base64(void)
+{
+    printf("------------------------------------------------------\n");
+    int rc;
+    static const char* vectors[][2] = {
+        { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+        { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" },
+    };
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        ccstring_t* encoded = ccstring_new_empty(0);
+        rc = ccstring_append_base64(&encoded, vectors[i][0], strlen(vectors[i][0]));
+        assert(rc == 0);
+        assert(strcmp(ccstring_get(encoded), vectors[i][1]) == 0);
+        ccstring_destroy(&encoded);
+    }
+
+    // Long enough to cross the vector block sizes, with every byte value present.
+    unsigned char payload[300];
+    for (size_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (unsigned char)(i * 37 + 11);
+    }
+
+    ccstring_t* hex = ccstring_new("hex:", 4);
+    rc = ccstring_append_hex(&hex, payload, sizeof(payload), CCSTRING_HEX_UPPERCASE);
+    assert(rc == 0);
+    assert(ccstring_length(hex) == 4 + 2 * sizeof(payload));
+    assert(memcmp(ccstring_get(hex), "hex:0B30557A", 12) == 0);
+    printf("Hex prefix: %.20s\n", ccstring_get(hex));
+
+    ccstring_t* base64 = ccstring_new_empty(0);
+    rc = ccstring_append_base64(&base64, payload, sizeof(payload));
+    assert(rc == 0);
+    assert(ccstring_length(base64) == 400);
+    printf("Base64 prefix: %.20s\n", ccstring_get(base64));
+
+    ccstring_t* decoded = ccstring_new_empty(0);
+    ccstring_view_t hex_text = { ccstring_get(hex) + 4, ccstring_length(hex) - 4 };
+    rc = ccstring_append_hex_decoded(&decoded, &hex_text);
+    assert(rc == 0);
+    assert(ccstring_length(decoded) == sizeof(payload));
+    assert(memcmp(ccstring_get(decoded), payload, sizeof(payload)) == 0);
+
+    ccstring_view_t base64_text = ccstring_view_of(base64);
+    rc = ccstring_append_base64_decoded(&decoded, &base64_text);
+    assert(rc == 0);
+    assert(ccstring_length(decoded) == 2 * sizeof(payload));
+    assert(memcmp(ccstring_get(decoded) + sizeof(payload), payload, sizeof(payload)) == 0);
+
+    // Unpadded input decodes; invalid input fails and leaves the string as it was.
+    ccstring_t* small = ccstring_new("x", 1);
+    ccstring_view_t unpadded = { "Zm9vYmE", 7 };
+    rc = ccstring_append_base64_decoded(&small, &unpadded);
+    assert(rc == 0);
+    assert(strcmp(ccstring_get(small), "xfooba") == 0);
+
+    char corrupted[400];
+    memcpy(corrupted, ccstring_get(base64), sizeof(corrupted));
+    corrupted[200] = '\x80';
+    ccstring_view_t bad_base64 = { corrupted, sizeof(corrupted) };
+    ccstring_view_t bad_hex = { "0g", 2 };
+    ccstring_view_t odd_hex = { "abc", 3 };
+    rc = ccstring_append_base64_decoded(&small, &bad_base64);
+    assert(rc != 0);
+    rc = ccstring_append_hex_decoded(&small, &bad_hex);
+    assert(rc != 0);
+    rc = ccstring_append_hex_decoded(&small, &odd_hex);
+    assert(rc != 0);
+    assert(strcmp(ccstring_get(small), "xfooba") == 0);
+
+    ccstring_destroy(&hex);
+    ccstring_destroy(&base64);
+    ccstring_destroy(&decoded);
+    ccstring_destroy(&small);
+    (void)rc;
+}
+
+static void example_json_and_csv_escaping(void)
+{
+    printf("------------------------------------------------------\n");
+    int rc;
+    ccstring_view_t raw = { "say \"hi\"\n\tpath\\to\x01", 18 };
+    ccstring_t* json = ccstring_new_empty(0);
+    rc = ccstring_append_json_escaped(&json, &raw);
+    assert(rc == 0);
+    printf("JSON escaped: %s\n", ccstring_get(json));
+    assert(strcmp(ccstring_get(json), "say \\\"hi\\\"\\n\\tpath\\\\to\\u0001") == 0);
+
+    ccstring_t* decoded = ccstring_new_empty(0);
+    ccstring_view_t escaped = ccstring_view_of(json);
+    rc = ccstring_append_json_unescaped(&decoded, &escaped);
+    assert(rc == 0);
+    assert(ccstring_length(decoded) == raw.length && memcmp(ccstring_get(decoded), raw.buffer, raw.length) == 0);
+
+    // Clean text longer than one vector block is copied unchanged.
+    ccstring_view_t clean = { "a clean string that needs no escaping at all", 44 };
+    rc = ccstring_append_json_escaped(&decoded, &clean);
+    assert(rc == 0);
+    assert(ccstring_length(decoded) == raw.length + clean.length);
+
+    ccstring_t* unicode = ccstring_new_empty(0);
+    ccstring_view_t code_points = { "\\u00e9\\ud83d\\ude00", 18 };
+    ccstring_view_t lone_surrogate = { "\\ud83d", 6 };
+    ccstring_view_t raw_quote = { "a\"b", 3 };
+    rc = ccstring_append_json_unescaped(&unicode, &code_points);
+    assert(rc == 0);
+    assert(strcmp(ccstring_get(unicode), "\xc3\xa9\xf0\x9f\x98\x80") == 0);
+    rc = ccstring_append_json_unescaped(&unicode, &lone_surrogate);
+    assert(rc != 0);
+    rc = ccstring_append_json_unescaped(&unicode, &raw_quote);
+    assert(rc != 0);
+    assert(ccstring_length(unicode) == 6);
+
+    ccstring_t* csv = ccstring_new_empty(0);
+    ccstring_view_t plain = { "plain", 5 };
+    ccstring_view_t quoted = { "a \"quoted\", field", 17 };
+    rc = ccstring_append_csv_escaped(&csv, &plain, ',');
+    assert(rc == 0);
+    rc = ccstring_append(&csv, ",", 1);
+    assert(rc == 0);
+    rc = ccstring_append_csv_escaped(&csv, &quoted, ',');
+    assert(rc == 0);
+    printf("CSV row: %s\n", ccstring_get(csv));
+    assert(strcmp(ccstring_get(csv), "plain,\"a \"\"quoted\"\", field\"") == 0);
+
+    ccstring_t* field = ccstring_new_empty(0);
+    ccstring_view_t quoted_field = { ccstring_get(csv) + 6, ccstring_length(csv) - 6 };
+    ccstring_view_t unbalanced = { "\"a\"b\"", 5 };
+    rc = ccstring_append_csv_unescaped(&field, &quoted_field);
+    assert(rc == 0);
+    assert(strcmp(ccstring_get(field), "a \"quoted\", field") == 0);
+    rc = ccstring_append_csv_unescaped(&field, &unbalanced);
+    assert(rc != 0);
+    assert(ccstring_length(field) == quoted.length);
+
+    ccstring_destroy(&json);
+    ccstring_destroy(&decoded);
+    ccstring_destroy(&unicode);
+    ccstring_destroy(&csv);
+    ccstring_destroy(&field);
+    (void)rc;
+}
+
+static void example_glob_and_regex(void)
+{
+    printf("------------------------------------------------------\n");
+    ccstring_view_t log_name = { "server-2025.log", 15 };
+    ccstring_view_t glob_log = { "server-*.log", 12 };
+    ccstring_view_t glob_year = { "*-20[0-9][0-9].???", 18 };
+    ccstring_view_t glob_other = { "client-*", 8 };
+    int rc = ccstring_glob_match(&glob_log, &log_name);
+    assert(rc == 0);
+    rc = ccstring_glob_match(&glob_year, &log_name);
+    assert(rc == 0);
+    rc = ccstring_glob_match(&glob_other, &log_name);
+    assert(rc != 0);
+
+    ccstring_view_t pattern = { "ERROR (disk|net)[a-z]* \\d+ms", 28 };
+    ccstring_regex_t* regex = ccstring_regex_new(&pattern);
+    assert(regex != NULL);
+
+    ccstring_view_t line = { "12:00:01 ERROR network 250ms retrying", 37 };
+    ccstring_slice_t match = { NULL, 0 };
+    rc = ccstring_regex_search(regex, &line, &match);
+    assert(rc == 0);
+    printf("Regex match: '%.*s'\n", (int)match.length, match.buffer ? match.buffer : "");
+    assert(match.buffer == line.buffer + 9 && match.length == 19);
+    rc = ccstring_regex_search(regex, &line, NULL);
+    assert(rc == 0);
+    rc = ccstring_regex_match(regex, &line);
+    assert(rc != 0);
+
+    ccstring_view_t quiet = { "12:00:02 INFO network 3ms", 25 };
+    rc = ccstring_regex_search(regex, &quiet, &match);
+    assert(rc != 0);
+    ccstring_regex_destroy(&regex);
+    assert(regex == NULL);
+
+    // Leftmost-longest: the earliest start wins, then the longest end from there.
+    ccstring_view_t alternatives = { "a|ab|abc", 8 };
+    ccstring_view_t text = { "xxabcab", 7 };
+    regex = ccstring_regex_new(&alternatives);
+    rc = ccstring_regex_search(regex, &text, &match);
+    assert(rc == 0 && match.buffer == text.buffer + 2 && match.length == 3);
+    ccstring_regex_destroy(&regex);
+
+    ccstring_view_t anchored = { "^[^ ]+ ok$", 10 };
+    ccstring_view_t good = { "job-7 ok", 8 };
+    ccstring_view_t bad = { "job 7 ok", 8 };
+    regex = ccstring_regex_new(&anchored);
+    rc = ccstring_regex_search(regex, &good, NULL);
+    assert(rc == 0);
+    rc = ccstring_regex_search(regex, &bad, NULL);
+    assert(rc != 0);
+    ccstring_regex_destroy(&regex);
+
+    // Anchors bind to their own alternative.
+    ccstring_view_t per_branch = { "^a|b", 4 };
+    ccstring_view_t later = { "xb", 2 };
+    regex = ccstring_regex_new(&per_branch);
+    assert(regex != NULL);
+    rc = ccstring_regex_search(regex, &later, &match);
+    assert(rc == 0 && match.buffer == later.buffer + 1 && match.length == 1);
+    ccstring_regex_destroy(&regex);
+
+    ccstring_view_t end_branch = { "a|b$", 4 };
+    ccstring_view_t trailing = { "bab", 3 };
+    regex = ccstring_regex_new(&end_branch);
+    assert(regex != NULL);
+    rc = ccstring_regex_search(regex, &trailing, &match);
+    assert(rc == 0 && match.buffer == trailing.buffer + 1 && match.length == 1);
+    ccstring_regex_destroy(&regex);
+
+    ccstring_view_t invalid = { "a{2}", 4 };
+    ccstring_view_t unbalanced = { "(ab", 3 };
+    regex = ccstring_regex_new(&invalid);
+    assert(regex == NULL);
+    regex = ccstring_regex_new(&unbalanced);
+    assert(regex == NULL);
+    (void)rc;
+}
+
+static void example_edit_distance(void)
+{
+    printf("------------------------------------------------------\n");
+    ccstring_view_t kitten = { "kitten", 6 };
+    ccstring_view_t sitting = { "sitting", 7 };
+    ccstring_view_t empty = { "", 0 };
+    size_t distance = 0;
+    int rc = ccstring_levenshtein(&kitten, &sitting, &distance);
+    assert(rc == 0);
+    printf("Distance kitten -> sitting: %zu\n", distance);
+    assert(distance == 3);
+    rc = ccstring_levenshtein(&kitten, &empty, &distance);
+    assert(rc == 0 && distance == 6);
+
+    rc = ccstring_levenshtein_bounded(&kitten, &sitting, 3, &distance);
+    assert(rc == 0 && distance == 3);
+    rc = ccstring_levenshtein_bounded(&kitten, &sitting, 2, &distance);
+    assert(rc == 0 && distance == 3);
+    rc = ccstring_levenshtein_bounded(&kitten, &sitting, 0, &distance);
+    assert(rc == 0 && distance == 1);
+
+    // Past 64 bytes the banded path takes over.
+    char long_a[200];
+    char long_b[200];
+    for (size_t i = 0; i < sizeof(long_a); ++i) {
+        long_a[i] = (char)('a' + (i * 7) % 26);
+    }
+    memcpy(long_b, long_a, sizeof(long_b));
+    long_b[10] = '#';
+    long_b[150] = '#';
+    ccstring_view_t view_a = { long_a, sizeof(long_a) };
+    ccstring_view_t view_b = { long_b, sizeof(long_b) - 1 };
+    rc = ccstring_levenshtein(&view_a, &view_b, &distance);
+    assert(rc == 0 && distance == 3);
+
+    ccstring_manager_t mgr = ccstring_manager_new(5000);
+    char name[16];
+    for (int i = 0; i < 5000; ++i) {
+        int length = snprintf(name, sizeof(name), "item-%04d", i);
+        rc = ccstring_manager_add(&mgr, ccstring_new(name, (size_t)length), 0);
+        assert(rc == 0);
+    }
+
+    ccstring_view_t query = { "item-1234", 9 };
+    ccstring_fuzzy_match_t matches[3] = { { 0, 0 }, { 0, 0 }, { 0, 0 } };
+    size_t count = 0;
+    rc = ccstring_manager_nearest(&mgr, &query, 1, matches, 3, &count);
+    assert(rc == 0 && count == 3);
+    for (size_t i = 0; i < count; ++i) {
+        printf("Nearest to '%.*s' #%zu: '%s' (%zu)\n", (int)query.length, query.buffer, i,
+            ccstring_get(mgr.list[matches[i].index]), matches[i].distance);
+    }
+    assert(matches[0].index == 1234 && matches[0].distance == 0);
+    assert(matches[1].index == 234 && matches[1].distance == 1);
+    assert(matches[2].index == 1034 && matches[2].distance == 1);
+
+    ccstring_view_t far = { "nothing-close", 13 };
+    rc = ccstring_manager_nearest(&mgr, &far, 2, matches, 3, &count);
+    assert(rc == 0 && count == 0);
+    ccstring_manager_destroy(&mgr);
+    (void)rc;
+}
+
 int main(void)
 {
     example_create_new_ccstring();
@@ -275,6 +924,17 @@ int main(void)
     example_append_ccstring();
     example_compare_ccstrings();
     example_manager_safe_use();
+    example_sort_ccstrings();
+    example_string_table();
+    example_string_table_file();
+    example_radix_tree();
+    example_stats();
+    example_literal_and_stack_strings();
+    example_split_view();
+    example_hex_and_base64();
+    example_json_and_csv_escaping();
+    example_glob_and_regex();
+    example_edit_distance();
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ccstring.hpp"
+
+static void example_owning_string(void)
+{
+    std::printf("------------------------------------------------------\n");
+    cc::string greeting("Hello");
+    greeting += ", World!";
+    assert(std::string_view(greeting) == "Hello, World!");
+
+    // Moving transfers the ccstring_t pointer; the source is left empty.
+    const ccstring_t* raw = greeting.get();
+    cc::string moved(std::move(greeting));
+    assert(moved.get() == raw);
+    (void)raw;
+    assert(greeting.get() == nullptr && greeting.empty());
+
+    cc::string copy = moved;
+    assert(copy.get() != moved.get() && copy == moved);
+
+    greeting = std::move(copy);
+    assert(greeting == moved && copy.get() == nullptr);
+
+    cc::string adopted = cc::string::adopt(ccstring_new("adopted", 7));
+    ccstring_t* released = adopted.release();
+    assert(adopted.get() == nullptr);
+    ccstring_destroy(&released);
+
+    static_assert(std::is_nothrow_move_constructible<cc::string>::value, "moves must not throw");
+    std::printf("C++ string: %s, Length: %zu\n", moved.c_str(), moved.size());
+}
+
+static void example_views_and_split(void)
+{
+    std::printf("------------------------------------------------------\n");
+    std::string_view text = "alpha,beta,,gamma";
+    cc::view view = text;
+    assert(view.data() == text.data() && view.size() == text.size());
+
+    std::vector<std::string_view> tokens;
+    for (cc::slice token : cc::split(view, ",")) {
+        tokens.push_back(token);
+        std::printf("Token: '%.*s'\n", static_cast<int>(token.size()), token.data());
+    }
+    assert(tokens.size() == 4);
+    assert(tokens[0] == "alpha" && tokens[1] == "beta" && tokens[2].empty() && tokens[3] == "gamma");
+    assert(tokens[3].data() == text.data() + 12);
+
+    cc::string owned("a::b");
+    size_t count = 0;
+    size_t bytes = 0;
+    for (cc::slice token : owned.split("::")) {
+        bytes += token.size();
+        count++;
+    }
+    assert(count == 2 && bytes == 2);
+    (void)bytes;
+
+    static ccstring_t fixed = CCSTRING_LITERAL_INIT("fixed");
+    cc::string literal = cc::string::adopt(&fixed);
+    bool threw = false;
+    try {
+        literal += "!";
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw && std::string_view(literal) == "fixed");
+    (void)threw;
+}
+
+int main(void)
+{
+    example_owning_string();
+    example_views_and_split();
+
+    return EXIT_SUCCESS;
+}